@@ -0,0 +1,185 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_async_apply.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Latency of a container pass with I/O-bound level functors
+///
+/// A container with eight levels is updated by a functor which loads a
+/// calibration constant from a file for the even levels and does a short
+/// computation for the odd levels. The file access is a stand-in for slow
+/// storage, every read is followed by a fixed device latency. The pass is run
+///  - sync:       for_each, one level after the other
+///  - inline:     for_each_async on rc_inline_executor, also sequential
+///  - pool:       for_each_async on rc_thread_pool with 4 threads
+///  - coroutine:  for_each_async on a pool of 1 thread with a coroutine
+///                functor which moves to an I/O pool of 4 threads for the
+///                file access and back for the computation
+/// The time per pass is reported, the container contents are compared.
+///
+/// Compilation:
+/// g++ --std=c++20 -O3 -pthread -I$BOOST_ROOT/include -o bench_async_apply bench_async_apply.cxx
+///
+/// Usage: bench_async_apply [npasses [latency]]
+///        npasses: number of container passes per mode, default 100
+///        latency: device latency of a file read in us, default 2000
+
+#include "runtime_container.h"
+#include "rc_async.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/fold.hpp>
+#include <boost/mpl/push_back.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::microseconds TimeScale;
+
+const int nLevels = 8;
+typedef boost::mpl::fold<boost::mpl::range_c<int, 0, nLevels>, boost::mpl::vector<>,
+                         boost::mpl::push_back<_1, double>>::type types;
+typedef create_rtc<types, RuntimeContainer<>>::type Container_t;
+
+std::string calibration_file(int level) { return "bench_async_apply_" + std::to_string(level) + ".dat"; }
+
+/// the file I/O stand-in: read the constant and wait for the device latency
+double read_calibration(int level, int latency)
+{
+  std::ifstream in(calibration_file(level));
+  double constant = 0.;
+  in >> constant;
+  std::this_thread::sleep_for(std::chrono::microseconds(latency));
+  return constant;
+}
+
+double compute(int level)
+{
+  double value = level;
+  for (int i = 0; i < 1000; i++) value = value * 0.999 + 0.001 * i;
+  return value;
+}
+
+/// synchronous level functor
+struct load_calibration {
+  typedef void return_type;
+  load_calibration(int latency) : mLatency(latency) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    const int level = T::level::value;
+    stage = level % 2 ? compute(level) : read_calibration(level, mLatency);
+  }
+  int mLatency;
+};
+
+/// coroutine level functor, the file is read on the I/O pool
+struct load_calibration_async {
+  typedef rc_task<void> return_type;
+  load_calibration_async(rc_thread_pool& compute, rc_thread_pool& io, int latency)
+    : mCompute(compute), mIO(io), mLatency(latency)
+  {
+  }
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    const int level = T::level::value;
+    double value;
+    if (level % 2) {
+      value = compute(level);
+    } else {
+      co_await mIO.schedule();
+      value = read_calibration(level, mLatency);
+      co_await mCompute.schedule();
+    }
+    stage = value;
+  }
+  rc_thread_pool& mCompute;
+  rc_thread_pool& mIO;
+  int mLatency;
+};
+
+struct compare_levels {
+  typedef void return_type;
+  compare_levels(const Container_t& reference, bool& equal) : mReference(reference), mEqual(equal) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    mEqual &= stage.get() == static_cast<const T&>(mReference).get();
+  }
+  const Container_t& mReference;
+  bool& mEqual;
+};
+
+template <typename F>
+double measure(int npasses, F pass)
+{
+  steady_clock::time_point refTime = steady_clock::now();
+  for (int i = 0; i < npasses; i++) pass();
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  return (double)duration.count() / npasses;
+}
+
+int main(int argc, char** argv)
+{
+  int npasses = argc > 1 ? std::atoi(argv[1]) : 100;
+  int latency = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+  for (int level = 0; level < nLevels; level += 2) {
+    std::ofstream out(calibration_file(level));
+    out << 1.5 * level + 0.25 << std::endl;
+  }
+
+  Container_t sync, inlined, pooled, coroutine;
+  rc_inline_executor inlineExecutor;
+  rc_thread_pool pool(4);
+  rc_thread_pool computePool(1);
+  rc_thread_pool ioPool(4);
+
+  double usSync = measure(npasses, [&]() { sync.for_each(load_calibration(latency)); });
+  double usInline =
+    measure(npasses, [&]() { rc_sync_wait(for_each_async(inlineExecutor, inlined, load_calibration(latency))); });
+  double usPool = measure(npasses, [&]() { rc_sync_wait(for_each_async(pool, pooled, load_calibration(latency))); });
+  double usCoroutine = measure(npasses, [&]() {
+    rc_sync_wait(for_each_async(computePool, coroutine, load_calibration_async(computePool, ioPool, latency)));
+  });
+
+  std::cout << std::setw(12) << "mode" << " " << std::setw(12) << "us/pass" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::setw(12) << "sync" << " " << std::setw(12) << usSync << std::endl;
+  std::cout << std::setw(12) << "inline" << " " << std::setw(12) << usInline << std::endl;
+  std::cout << std::setw(12) << "pool" << " " << std::setw(12) << usPool << std::endl;
+  std::cout << std::setw(12) << "coroutine" << " " << std::setw(12) << usCoroutine << std::endl;
+
+  bool ok = true;
+  inlined.for_each(compare_levels(sync, ok));
+  pooled.for_each(compare_levels(sync, ok));
+  coroutine.for_each(compare_levels(sync, ok));
+  ok &= rc_sync_wait(apply_async(pool, pooled, 2, get_value<double>())) == 3.25;
+  try {
+    rc_sync_wait(apply_async(pool, pooled, nLevels, get_value<double>()));
+    ok = false;
+  } catch (const std::out_of_range&) {
+  }
+  std::cout << "results " << (ok ? "ok" : "failed") << std::endl;
+
+  for (int level = 0; level < nLevels; level += 2) std::remove(calibration_file(level).c_str());
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_bounds.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Cost of the bounds policies of the runtime dispatch
+///
+/// Reads the levels of a container with eight levels through apply at a
+/// sequence of random indices, all in range, with the bounds policies
+///  - default:    rc_bounds_default, value initialized return for out of range
+///  - unchecked:  rc_bounds_unchecked, out of range is unreachable
+///  - throw:      rc_bounds_throw, std::out_of_range
+///  - error code: apply(index, f, ec), explicit check and unchecked dispatch
+/// The time per call is reported, the sums of all modes are compared. apply
+/// at indices out of range must follow the bounds policy RC_BOUNDS_POLICY,
+/// also with the unrolled dispatch of RC_UNROLL.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -I$BOOST_ROOT/include -o bench_bounds bench_bounds.cxx
+/// with unrolling and the throw policy for apply:
+/// g++ --std=c++11 -O3 -DRC_UNROLL -DRC_BOUNDS_POLICY=gNeric::rc_bounds_throw -I$BOOST_ROOT/include -o bench_bounds bench_bounds.cxx
+///
+/// Usage: bench_bounds [nrolls]
+///        nrolls: number of calls per mode, default 100000000
+
+#include "runtime_container.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <system_error>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+#include <boost/mpl/vector.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+typedef boost::mpl::vector<int, float, double, long long, unsigned int, long, short, double> types;
+typedef create_rtc<types, RuntimeContainer<DefaultInterface, funny_initializer>>::type Container_t;
+
+template <typename F>
+double measure(int nrolls, double& sum, F f)
+{
+  steady_clock::time_point refTime = steady_clock::now();
+  for (int roll = 0; roll < nrolls; roll++) {
+    sum += f(roll);
+  }
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  return (double)duration.count() / nrolls;
+}
+
+/// apply and apply_bounded<RC_BOUNDS_POLICY> give the same result out of range
+bool check_policy(Container_t& container)
+{
+  if (std::is_same<RC_BOUNDS_POLICY, rc_bounds_unchecked>::value) return true;
+  bool ok = true;
+  for (int index : {-1, 8, 9, 12}) {
+    bool thrown[2] = {false, false};
+    double values[2] = {0., 0.};
+    try {
+      values[0] = container.apply(index, get_value<double>());
+    } catch (const std::out_of_range&) {
+      thrown[0] = true;
+    }
+    try {
+      values[1] = container.apply_bounded<RC_BOUNDS_POLICY>(index, get_value<double>());
+    } catch (const std::out_of_range&) {
+      thrown[1] = true;
+    }
+    ok &= thrown[0] == thrown[1] && values[0] == values[1];
+  }
+  return ok;
+}
+
+int main(int argc, char** argv)
+{
+  int nrolls = argc > 1 ? std::atoi(argv[1]) : 100000000;
+
+  Container_t container;
+  const int nindices = 4096;
+  std::vector<int> indices(nindices);
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(0, container.size() - 1);
+  for (auto& index : indices) index = distribution(generator);
+  const int* sequence = indices.data();
+
+  const char* modes[] = {"default", "unchecked", "throw", "error code"};
+  double sums[4] = {0., 0., 0., 0.};
+  double ns[4];
+  ns[0] = measure(nrolls, sums[0], [&](int roll) {
+    return container.apply_bounded<rc_bounds_default>(sequence[roll % nindices], get_value<double>());
+  });
+  ns[1] = measure(nrolls, sums[1], [&](int roll) {
+    return container.apply_bounded<rc_bounds_unchecked>(sequence[roll % nindices], get_value<double>());
+  });
+  ns[2] = measure(nrolls, sums[2], [&](int roll) {
+    return container.apply_bounded<rc_bounds_throw>(sequence[roll % nindices], get_value<double>());
+  });
+  std::error_code ec;
+  int nerrors = 0;
+  ns[3] = measure(nrolls, sums[3], [&](int roll) {
+    double value = container.apply(sequence[roll % nindices], get_value<double>(), ec);
+    nerrors += ec ? 1 : 0;
+    return value;
+  });
+
+  std::cout << std::setw(12) << "mode" << " " << std::setw(10) << "ns/call" << std::endl;
+  std::cout << std::fixed << std::setprecision(3);
+  bool ok = nerrors == 0 && check_policy(container);
+  for (int mode = 0; mode < 4; mode++) {
+    std::cout << std::setw(12) << modes[mode] << " " << std::setw(10) << ns[mode] << std::endl;
+    ok &= sums[mode] == sums[0];
+  }
+  std::cout << "results " << (ok ? "ok" : "failed") << std::endl;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_columnar.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Write and read runtime containers in the columnar format
+///
+/// A sequence of containers with 16 levels of type double is written to a
+/// file with rc_column_writer, then read back with rc_column_reader selecting
+/// all, 4 and 1 level. The time and the bytes read from the file are reported,
+/// the sum of the selected columns is checked against the written data.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -I$BOOST_ROOT/include -o bench_columnar bench_columnar.cxx
+///
+/// Usage: bench_columnar [ncontainers [file]]
+///        ncontainers: number of containers, default 4000000
+///        file:        data file, default bench_columnar.dat, removed at the end
+
+#include "runtime_container.h"
+#include "rc_columnar.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/fold.hpp>
+#include <boost/mpl/push_back.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::milliseconds TimeScale;
+
+const int nLevels = 16;
+typedef boost::mpl::fold<boost::mpl::range_c<int, 0, nLevels>, boost::mpl::vector<>,
+                         boost::mpl::push_back<_1, double>>::type types;
+typedef create_rtc<types, RuntimeContainer<>>::type Container_t;
+
+/// set the value of each level to row + level
+struct set_row {
+  typedef void return_type;
+  set_row(double row) : mRow(row) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    stage = mRow + T::level::value;
+  }
+  double mRow;
+};
+
+/// read all blocks with the selected levels, returns the sum of the selected columns
+double read_file(const char* filename, const std::vector<int>& levels, long long& bytes)
+{
+  std::ifstream in(filename, std::ios::binary);
+  rc_column_reader<Container_t> reader(in);
+  reader.select(levels);
+  double sum = 0.;
+  std::size_t rows;
+  while ((rows = reader.next()) > 0) {
+    for (int level : levels) {
+      const double* column = reader.column<double>(level);
+      for (std::size_t row = 0; row < rows; row++) sum += column[row];
+      bytes += rows * sizeof(double);
+    }
+  }
+  return sum;
+}
+
+int main(int argc, char** argv)
+{
+  long long ncontainers = argc > 1 ? std::atoll(argv[1]) : 4000000;
+  const char* filename = argc > 2 ? argv[2] : "bench_columnar.dat";
+
+  std::vector<Container_t> containers(1024);
+  steady_clock::time_point refTime = steady_clock::now();
+  {
+    std::ofstream out(filename, std::ios::binary);
+    rc_column_writer<Container_t> writer(out);
+    for (long long row = 0; row < ncontainers; row += containers.size()) {
+      std::size_t n = std::min<long long>(containers.size(), ncontainers - row);
+      for (std::size_t i = 0; i < n; i++) containers[i].for_each(set_row(row + i));
+      writer.write(containers.begin(), containers.begin() + n);
+    }
+  }
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  std::cout << "written " << ncontainers << " containers of " << nLevels << " levels in " << duration.count()
+            << " ms" << std::endl;
+
+  std::cout << std::setw(8) << "levels" << " " << std::setw(10) << "time/ms" << " " << std::setw(12) << "MB read"
+            << " check" << std::endl;
+  bool failed = false;
+  const std::vector<std::vector<int>> selections = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}, {0, 5, 10, 15}, {7}};
+  for (auto& levels : selections) {
+    long long bytes = 0;
+    refTime = steady_clock::now();
+    double sum = read_file(filename, levels, bytes);
+    duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+    // sum over rows of (row + level) for the selected levels
+    double expected = 0.;
+    for (int level : levels) expected += (double)ncontainers * (ncontainers - 1) / 2 + (double)ncontainers * level;
+    bool ok = sum == expected;
+    failed |= !ok;
+    std::cout << std::setw(8) << levels.size() << " " << std::setw(10) << duration.count() << " " << std::setw(12)
+              << std::fixed << std::setprecision(1) << bytes / 1e6 << " " << (ok ? "ok" : "failed") << std::endl;
+  }
+  std::remove(filename);
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_concurrent_update.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Concurrent updates of one shared runtime container
+///
+/// A number of threads increment the levels of one shared runtime container,
+/// every thread cycles through the levels. Three variants are compared
+///  - atomic:  levels wrapped in atomic_member or sharded_member, see rc_atomic.h
+///  - mutex:   plain container, every update protected by one mutex
+///  - sharded: one replica of the plain container per thread, see rc_sharded.h,
+///             the time includes the final reduction of the replicas
+/// The result is reported as ns per update and million updates per second,
+/// the sum over all levels is checked against the number of updates.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -pthread -I$BOOST_ROOT/include -o bench_concurrent_update bench_concurrent_update.cxx
+///
+/// Usage: bench_concurrent_update [nupdates [maxthreads]]
+///        nupdates:   number of updates per thread, default 1000000
+///        maxthreads: maximum number of threads, default twice the number of cores
+
+#include "runtime_container.h"
+#include "rc_atomic.h"
+#include "rc_sharded.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include <boost/mpl/vector.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/mpl/for_each.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+/// long double is not lock-free and uses the sharded fallback
+typedef boost::mpl::vector<int, unsigned long, float, double, long double> types;
+const int nLevels = boost::mpl::size<types>::value;
+
+typedef create_rtc<rc_atomic_types<types>::type, RuntimeContainer<>>::type AtomicContainer;
+typedef create_rtc<types, RuntimeContainer<>>::type PlainContainer;
+typedef ShardedContainer<PlainContainer> Sharded;
+
+/// print the member wrapper selected for each type
+struct print_wrapper {
+  template <typename T>
+  void operator()(T)
+  {
+    std::cout << " " << sizeof(T) << "-byte " << (rc_is_lock_free<T>::value ? "atomic" : "sharded");
+  }
+};
+
+/// update function of the atomic container, no synchronization required
+struct atomic_update {
+  atomic_update(AtomicContainer& container) : mContainer(container) {}
+  void operator()(int, int index) { mContainer.apply(index, add_value<int>(1)); }
+  AtomicContainer& mContainer;
+};
+
+/// update function of the plain container, one global lock
+struct mutex_update {
+  mutex_update(PlainContainer& container, std::mutex& mutex) : mContainer(container), mMutex(mutex) {}
+  void operator()(int, int index)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mContainer.apply(index, add_value<int>(1));
+  }
+  PlainContainer& mContainer;
+  std::mutex& mMutex;
+};
+
+/// update function of the sharded container, every thread has its own replica
+struct sharded_update {
+  sharded_update(Sharded& container) : mContainer(container) {}
+  void operator()(int thread, int index) { mContainer.apply(thread, index, add_value<int>(1)); }
+  Sharded& mContainer;
+};
+
+template <typename ContainerT>
+double sum_levels(ContainerT& container)
+{
+  double sum = 0.;
+  for (int index = 0; index < nLevels; index++) {
+    sum += container.apply(index, get_value<double>());
+  }
+  return sum;
+}
+
+/// run the update function from nthreads threads, returns the duration in ns
+template <typename UpdateT>
+double measure(int nthreads, long long nupdates, UpdateT update)
+{
+  std::vector<std::thread> threads;
+  steady_clock::time_point refTime = steady_clock::now();
+  for (int t = 0; t < nthreads; t++) {
+    threads.emplace_back([t, nupdates, update]() mutable {
+      int index = t % nLevels;
+      for (long long i = 0; i < nupdates; i++) {
+        update(t, index);
+        if (++index == nLevels) index = 0;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  return std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime).count();
+}
+
+void print_row(int nthreads, const char* variant, double ns, long long nupdates, double sum)
+{
+  long long total = nthreads * nupdates;
+  std::cout << std::setw(8) << nthreads << " "
+            << std::setw(8) << variant << " "
+            << std::setw(10) << std::fixed << std::setprecision(2) << ns / nupdates << " "
+            << std::setw(12) << std::setprecision(2) << total * 1000. / ns << " "
+            << (sum == total ? "ok" : "failed") << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  long long nupdates = argc > 1 ? std::atoll(argv[1]) : 1000000;
+  int maxthreads = argc > 2 ? std::atoi(argv[2]) : 2 * std::max(1u, std::thread::hardware_concurrency());
+
+  std::cout << "member wrappers:";
+  boost::mpl::for_each<types>(print_wrapper());
+  std::cout << std::endl;
+  std::cout << std::setw(8) << "threads" << " "
+            << std::setw(8) << "variant" << " "
+            << std::setw(10) << "ns/update" << " "
+            << std::setw(12) << "Mupdates/s" << " "
+            << "check" << std::endl;
+
+  bool failed = false;
+  for (int nthreads = 1; nthreads <= maxthreads; nthreads *= 2) {
+    AtomicContainer atomicContainer;
+    double ns = measure(nthreads, nupdates, atomic_update(atomicContainer));
+    double sum = sum_levels(atomicContainer);
+    failed |= sum != nthreads * nupdates;
+    print_row(nthreads, "atomic", ns, nupdates, sum);
+
+    PlainContainer plainContainer;
+    std::mutex mutex;
+    ns = measure(nthreads, nupdates, mutex_update(plainContainer, mutex));
+    sum = sum_levels(plainContainer);
+    failed |= sum != nthreads * nupdates;
+    print_row(nthreads, "mutex", ns, nupdates, sum);
+
+    Sharded sharded(nthreads);
+    steady_clock::time_point refTime = steady_clock::now();
+    ns = measure(nthreads, nupdates, sharded_update(sharded));
+    PlainContainer reduced = sharded.reduce();
+    ns = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime).count();
+    sum = sum_levels(reduced);
+    failed |= sum != nthreads * nupdates;
+    print_row(nthreads, "sharded", ns, nupdates, sum);
+  }
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_expression.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Container-wide arithmetic with expression templates
+///
+/// Evaluates c = a + 2 * b for containers with eight levels of columns
+/// (std::vector<double> and std::vector<float>) in three ways
+///  - temporary:  one pass per operation with a temporary container
+///  - functor:    handwritten fused functor applied to every level index
+///  - expression: expression templates of rc_expression.h
+/// The result is reported in ns per element, the results are compared.
+///
+/// Compilation:
+/// g++ --std=c++14 -O3 -I$BOOST_ROOT/include -o bench_expression bench_expression.cxx
+///
+/// Usage: bench_expression [nrolls [nelements]]
+///        nrolls:    number of evaluations, default 1000
+///        nelements: number of elements per column, default 10000
+
+#include "runtime_container.h"
+#include "rc_expression.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <boost/mpl/vector.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+typedef std::vector<double> DColumn;
+typedef std::vector<float> FColumn;
+typedef boost::mpl::vector<DColumn, FColumn, DColumn, FColumn, DColumn, FColumn, DColumn, FColumn> types;
+typedef create_rtc<types, RuntimeContainer<>>::type Container_t;
+const int nLevels = 8;
+
+/// fill the columns with nelements values
+struct fill_columns {
+  typedef void return_type;
+  fill_columns(std::size_t nelements, double offset) : mNElements(nelements), mOffset(offset) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    auto& column = *stage;
+    column.resize(mNElements);
+    for (std::size_t i = 0; i < mNElements; i++) column[i] = mOffset + T::level::value + 0.001 * i;
+  }
+  std::size_t mNElements;
+  double mOffset;
+};
+
+/// target = source * factor
+struct scale_columns {
+  typedef void return_type;
+  scale_columns(const Container_t& source, double factor) : mSource(source), mFactor(factor) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    auto& target = *stage;
+    const auto& source = *static_cast<const T&>(mSource);
+    target.resize(source.size());
+    for (std::size_t i = 0; i < source.size(); i++) target[i] = source[i] * mFactor;
+  }
+  const Container_t& mSource;
+  double mFactor;
+};
+
+/// target = first + second
+struct add_columns {
+  typedef void return_type;
+  add_columns(const Container_t& first, const Container_t& second) : mFirst(first), mSecond(second) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    auto& target = *stage;
+    const auto& first = *static_cast<const T&>(mFirst);
+    const auto& second = *static_cast<const T&>(mSecond);
+    target.resize(first.size());
+    for (std::size_t i = 0; i < first.size(); i++) target[i] = first[i] + second[i];
+  }
+  const Container_t& mFirst;
+  const Container_t& mSecond;
+};
+
+/// target = a + factor * b in one loop
+struct axpy_columns {
+  typedef void return_type;
+  axpy_columns(const Container_t& a, const Container_t& b, double factor) : mA(a), mB(b), mFactor(factor) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    auto& target = *stage;
+    const auto& a = *static_cast<const T&>(mA);
+    const auto& b = *static_cast<const T&>(mB);
+    target.resize(a.size());
+    for (std::size_t i = 0; i < a.size(); i++) target[i] = a[i] + mFactor * b[i];
+  }
+  const Container_t& mA;
+  const Container_t& mB;
+  double mFactor;
+};
+
+/// compare the columns with a reference container
+struct compare_columns {
+  typedef void return_type;
+  compare_columns(const Container_t& reference, bool& equal) : mReference(reference), mEqual(equal) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    mEqual &= stage.get() == static_cast<const T&>(mReference).get();
+  }
+  const Container_t& mReference;
+  bool& mEqual;
+};
+
+template <typename F>
+double measure(int nrolls, std::size_t nelements, F f)
+{
+  steady_clock::time_point refTime = steady_clock::now();
+  for (int roll = 0; roll < nrolls; roll++) {
+    f();
+  }
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  return (double)duration.count() / ((double)nrolls * nLevels * nelements);
+}
+
+bool equal(Container_t& result, const Container_t& reference)
+{
+  bool equal = true;
+  result.for_each(compare_columns(reference, equal));
+  return equal;
+}
+
+int main(int argc, char** argv)
+{
+  int nrolls = argc > 1 ? std::atoi(argv[1]) : 1000;
+  std::size_t nelements = argc > 2 ? std::atoll(argv[2]) : 10000;
+
+  Container_t a, b, temporary, cTemporary, cFunctor, cExpression;
+  a.for_each(fill_columns(nelements, 1.));
+  b.for_each(fill_columns(nelements, 2.));
+
+  double nsTemporary = measure(nrolls, nelements, [&]() {
+    temporary.for_each(scale_columns(b, 2.));
+    cTemporary.for_each(add_columns(a, temporary));
+  });
+  double nsFunctor = measure(nrolls, nelements, [&]() {
+    for (int index = 0; index < nLevels; index++) cFunctor.apply(index, axpy_columns(a, b, 2.));
+  });
+  double nsExpression = measure(nrolls, nelements, [&]() { cExpression = a + 2. * b; });
+
+  std::cout << std::setw(12) << "evaluation" << " " << std::setw(12) << "ns/element" << std::endl;
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << std::setw(12) << "temporary" << " " << std::setw(12) << nsTemporary << std::endl;
+  std::cout << std::setw(12) << "functor" << " " << std::setw(12) << nsFunctor << std::endl;
+  std::cout << std::setw(12) << "expression" << " " << std::setw(12) << nsExpression << std::endl;
+
+  bool ok = equal(cExpression, cFunctor) && equal(cTemporary, cFunctor);
+  std::cout << "results " << (ok ? "ok" : "failed") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_heterogeneous_vector.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Benchmark of the heterogeneous vector against a vector of pointers
+///
+/// A sequence of objects with randomly distributed types is processed
+///  - as std::vector<Interface*> with one object allocated per element and
+///    a virtual call per element
+///  - as HeterogeneousVector in insertion order, one dispatch per element
+///  - as HeterogeneousVector grouped by type, no dispatch in the loops
+///
+/// The second part computes one result per element, with a dispatch per element
+/// and with the type-sorted transform in grouped and in restored original order.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -I$BOOST_ROOT/include -o bench_heterogeneous_vector bench_heterogeneous_vector.cxx
+///
+/// Usage: bench_heterogeneous_vector [nelements] [nrolls]
+
+#include "heterogeneous_vector.h"
+#include "type_wrapper.h"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <boost/mpl/vector.hpp>
+#include <boost/mpl/for_each.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/mpl/transform.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+typedef boost::mpl::vector<int, float, short, double, char, uint64_t> wrapped_types;
+/// the elements stored by value, without the virtual interface
+typedef boost::mpl::transform<wrapped_types, TypeWrapper<_1, NoInterface> >::type types;
+typedef HeterogeneousVector<types> Vector_t;
+
+/// add an element of the type at position 'tag' to all containers
+struct add_element {
+  add_element(std::vector<std::unique_ptr<Interface>>& pointers, std::vector<Vector_t>& vectors, int tag)
+    : mPointers(pointers), mVectors(vectors), mTag(tag), mIndex(0) {}
+  template<typename T>
+  void operator()(T) {
+    if (mIndex++ != mTag) return;
+    mPointers.emplace_back(new TypeWrapper<T, Interface>);
+    for (auto& elements : mVectors) {
+      elements.push_back(TypeWrapper<T, NoInterface>());
+    }
+  }
+
+  std::vector<std::unique_ptr<Interface>>& mPointers;
+  std::vector<Vector_t>& mVectors;
+  int mTag;
+  int mIndex;
+};
+
+struct increment {
+  typedef void return_type;
+  template<typename T>
+  return_type operator()(T& element) { element += 1; }
+};
+
+struct sum {
+  typedef void return_type;
+  sum(double& s) : mSum(s) {}
+  template<typename T>
+  return_type operator()(T& element) { mSum += element.value(); }
+  double& mSum;
+};
+
+struct scaled_value {
+  typedef double return_type;
+  template<typename T>
+  return_type operator()(T& element) { return 0.5 * element.value(); }
+};
+
+template<typename F>
+long long measure(int nrolls, F f)
+{
+  steady_clock::time_point refTime = steady_clock::now();
+  for (int roll = 0; roll < nrolls; roll++) {
+    f();
+  }
+  return std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime).count();
+}
+
+int main(int argc, char** argv)
+{
+  int nelements = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  int nrolls = argc > 2 ? std::atoi(argv[2]) : 100;
+
+  // one heterogeneous vector for each of the two iteration modes
+  std::vector<std::unique_ptr<Interface>> pointers;
+  std::vector<Vector_t> vectors(2);
+  Vector_t& elements = vectors[0];
+  Vector_t& grouped = vectors[1];
+  pointers.reserve(nelements);
+  elements.reserve(nelements);
+  grouped.reserve(nelements);
+  std::default_random_engine generator;
+  std::uniform_int_distribution<int> tags(0, boost::mpl::size<types>::value - 1);
+  for (int i = 0; i < nelements; i++) {
+    boost::mpl::for_each<wrapped_types>(add_element(pointers, vectors, tags(generator)));
+  }
+
+  long long durationPointers = measure(nrolls, [&]() {
+    for (auto& element : pointers) {
+      *element += 1;
+    }
+  });
+  long long durationInsertion = measure(nrolls, [&]() { elements.for_each(increment()); });
+  long long durationGrouped = measure(nrolls, [&]() { grouped.for_each_grouped(increment()); });
+
+  // results verification, all containers have been incremented the same
+  // number of times
+  double sumPointers = 0.;
+  for (auto& element : pointers) {
+    sumPointers += element->value();
+  }
+  double sumElements = 0.;
+  elements.for_each(sum(sumElements));
+  double sumGrouped = 0.;
+  grouped.for_each_grouped(sum(sumGrouped));
+
+  double ncalls = (double)nelements * nrolls;
+  std::cout << nelements << " element(s), " << nrolls << " iteration(s)" << std::endl;
+  std::cout << "vector of pointers:                " << std::setw(8) << std::setprecision(4)
+            << durationPointers / ncalls << " ns/element" << std::endl;
+  std::cout << "heterogeneous vector, insertion:   " << std::setw(8) << std::setprecision(4)
+            << durationInsertion / ncalls << " ns/element" << std::endl;
+  std::cout << "heterogeneous vector, grouped:     " << std::setw(8) << std::setprecision(4)
+            << durationGrouped / ncalls << " ns/element" << std::endl;
+  std::cout << "checksum: " << std::setprecision(12) << sumPointers << " " << sumElements << " " << sumGrouped
+            << std::endl;
+  if (sumPointers != sumElements || sumPointers != sumGrouped) {
+    std::cerr << "checksum mismatch" << std::endl;
+    return 1;
+  }
+
+  // per element results
+  std::vector<double> resultDispatch(nelements);
+  std::vector<double> resultGrouped;
+  std::vector<double> resultRestored;
+  long long durationDispatch = measure(nrolls, [&]() {
+    for (int i = 0; i < nelements; i++) {
+      resultDispatch[i] = elements.apply(i, scaled_value());
+    }
+  });
+  long long durationTransformGrouped = measure(nrolls, [&]() { elements.transform(scaled_value(), resultGrouped); });
+  Vector_t::partition_type partition;
+  long long durationPartition = measure(nrolls, [&]() { partition = elements.partition(); });
+  long long durationTransformRestored = measure(nrolls, [&]() {
+    elements.transform(scaled_value(), resultRestored, partition);
+  });
+  std::cout << "results, dispatch per element:     " << std::setw(8) << std::setprecision(4)
+            << durationDispatch / ncalls << " ns/element" << std::endl;
+  std::cout << "results, transform grouped order:  " << std::setw(8) << std::setprecision(4)
+            << durationTransformGrouped / ncalls << " ns/element" << std::endl;
+  std::cout << "results, transform original order: " << std::setw(8) << std::setprecision(4)
+            << durationTransformRestored / ncalls << " ns/element"
+            << " (+ partition " << durationPartition / ncalls << " ns/element)" << std::endl;
+  if (resultRestored != resultDispatch) {
+    std::cerr << "result mismatch" << std::endl;
+    return 1;
+  }
+  for (std::size_t i = 0; i < partition.size(); i++) {
+    if (resultGrouped[i] != resultDispatch[partition.positions()[i]]) {
+      std::cerr << "result mismatch in grouped order" << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
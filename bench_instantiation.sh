@@ -0,0 +1,114 @@
+#!/bin/bash
+#****************************************************************************
+#* This file is free software: you can redistribute it and/or modify        *
+#* it under the terms of the GNU General Public License as published by     *
+#* the Free Software Foundation, either version 3 of the License, or        *
+#* (at your option) any later version.                                      *
+#*                                                                          *
+#* Primary Author(s): agent <agent@local>                                   *
+#*                                                                          *
+#* The authors make no claims about the suitability of this software for    *
+#* any purpose. It is provided "as is" without express or implied warranty. *
+#****************************************************************************
+
+# Build time and code size with explicit instantiation
+#
+# Compiles instantiation_demo from the main unit and nunits units of
+# instantiation_demo_unit.cxx, with the functions of the container declared
+# extern and instantiated in instantiation_demo.cxx, and with
+# RC_NO_EXTERN_TEMPLATES where every unit instantiates them itself. Prints
+# one markdown table with the compile time summed over the units, the link
+# time, the .text size summed over the objects and the .text size of the
+# program for every optimization level. Both programs are run and their
+# output is compared.
+#
+# The instantiation unit is compiled once, the saving grows with the number
+# of units using the container.
+#
+# Usage: ./bench_instantiation.sh [nunits] [build directory]
+#   nunits           number of units using the container, default 8
+#   build directory  default ./bench-instantiation
+#
+# Environment: CXX (default g++), OPTLEVELS (default "-O0 -O2"), CXXFLAGS,
+# BOOST_INCLUDE include directory of boost if not in the default path
+
+set -e
+
+NUNITS=${1:-8}
+BUILDDIR=${2:-$PWD/bench-instantiation}
+SOURCEDIR=$(cd "$(dirname "$0")" && pwd)
+CXX=${CXX:-g++}
+OPTLEVELS=${OPTLEVELS:-"-O0 -O2"}
+INCLUDES="-I$SOURCEDIR"
+if [ -n "$BOOST_INCLUDE" ]; then
+  INCLUDES="$INCLUDES -I$BOOST_INCLUDE"
+fi
+
+now() {
+  date +%s%N
+}
+
+# .text size of object files or programs, including the sections of the
+# template instantiations
+text_size() {
+  size -A "$@" | awk '$1 ~ /^\.text/ {sum += $2} END {print sum}'
+}
+
+# compile one unit, prints the time in ns
+# compile <source> <object> <flags>
+compile() {
+  local begin end
+  begin=$(now)
+  $CXX $3 -c "$SOURCEDIR/$1.cxx" -o "$2"
+  end=$(now)
+  echo $((end - begin))
+}
+
+# compile the units and link
+# build <dir> <optlevel> <mode>, mode is extern or implicit
+build() {
+  local dir=$1 opt=$2 mode=$3
+  local flags="-std=c++11 $opt $CXXFLAGS $INCLUDES"
+  if [ "$mode" = "implicit" ]; then
+    flags="$flags -DRC_NO_EXTERN_TEMPLATES"
+  fi
+  mkdir -p "$dir"
+  local begin end time=0 objects="$dir/main.o"
+  time=$((time + $(compile instantiation_demo_main "$dir/main.o" "$flags")))
+  for ((unit = 0; unit < NUNITS; unit++)); do
+    time=$((time + $(compile instantiation_demo_unit "$dir/unit$unit.o" "$flags")))
+    objects="$objects $dir/unit$unit.o"
+  done
+  if [ "$mode" = "extern" ]; then
+    time=$((time + $(compile instantiation_demo "$dir/instantiation.o" "$flags")))
+    objects="$objects $dir/instantiation.o"
+  fi
+  begin=$(now)
+  $CXX $objects -o "$dir/instantiation_demo"
+  end=$(now)
+  echo "$((time / 1000000)) $(((end - begin) / 1000000)) $(text_size $objects) $(text_size "$dir/instantiation_demo")"
+}
+
+mkdir -p "$BUILDDIR"
+TABLE="$BUILDDIR/results.md"
+{
+  echo "| opt | mode | compile/ms | link/ms | objects .text | program .text |"
+  echo "|-----|------|-----------:|--------:|--------------:|--------------:|"
+} > "$TABLE"
+
+for opt in $OPTLEVELS; do
+  dir="$BUILDDIR/$CXX$opt"
+  echo "building $dir" >&2
+  read -r compile link objects program <<< "$(build "$dir-extern" "$opt" extern)"
+  echo "| $opt | extern | $compile | $link | $objects | $program |" >> "$TABLE"
+  read -r compile link objects program <<< "$(build "$dir-implicit" "$opt" implicit)"
+  echo "| $opt | implicit | $compile | $link | $objects | $program |" >> "$TABLE"
+  if ! cmp -s <("$dir-extern/instantiation_demo") <("$dir-implicit/instantiation_demo"); then
+    echo "output of the programs differs for $opt" >&2
+    exit 1
+  fi
+done
+
+echo
+echo "instantiation_demo with $NUNITS units, compile time summed over the units, .text in bytes"
+cat "$TABLE"
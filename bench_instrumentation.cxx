@@ -0,0 +1,160 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_instrumentation.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Per-level timing of container passes and its overhead
+///
+/// A container holds levels of very different cost: a long vector, a short
+/// vector, a string and plain numbers. A functor sums every level, the
+/// container is passed with for_each npasses times for the instrumentation
+/// policies
+///  - none:   no_instrumentation
+///  - steady: rc_timing_instrumentation with rc_steady_clock
+///  - tsc:    rc_timing_instrumentation with rc_tsc_clock
+/// The time per pass is reported for every policy, and the table of the tsc
+/// policy as CSV and in the collapsed stack format. With an output prefix
+/// the table is written to prefix.csv and prefix.folded, the latter can be
+/// passed to flamegraph.pl. The sums and the call counts are checked.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -pthread -I$BOOST_ROOT/include -o bench_instrumentation bench_instrumentation.cxx
+///
+/// Usage: bench_instrumentation [npasses [prefix]]
+///        npasses: number of passes over the container, default 100000
+///        prefix:  write the table to prefix.csv and prefix.folded
+
+#include "runtime_container.h"
+#include "rc_instrumentation.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <numeric>
+#include <chrono>
+#include <cstdlib>
+#include <boost/mpl/vector.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+struct long_tag {
+  static constexpr const char* name() { return "long_vector"; }
+};
+struct short_tag {
+  static constexpr const char* name() { return "short_vector"; }
+};
+struct label_tag {
+  static constexpr const char* name() { return "label"; }
+};
+struct count_tag {
+  static constexpr const char* name() { return "count"; }
+};
+struct weight_tag {
+  static constexpr const char* name() { return "weight"; }
+};
+
+typedef boost::mpl::vector<tagged<long_tag, std::vector<double>>, tagged<short_tag, std::vector<double>>,
+                           tagged<label_tag, std::string>, tagged<count_tag, int>, tagged<weight_tag, double>>
+  types;
+
+template <typename Instrumentation>
+struct container_type {
+  typedef RuntimeContainer<DefaultInterface, default_initializer, default_printer, no_tracking, Instrumentation> base;
+  typedef typename create_rtc<types, base>::type type;
+};
+
+/// sum of a level
+struct sum_level {
+  typedef void return_type;
+  sum_level(double& sum) : mSum(sum) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    mSum += value(*stage);
+  }
+  static double value(const std::vector<double>& v) { return std::accumulate(v.begin(), v.end(), 0.); }
+  static double value(const std::string& s) { return std::accumulate(s.begin(), s.end(), 0); }
+  template <typename V>
+  static double value(const V& v)
+  {
+    return v;
+  }
+  double& mSum;
+};
+
+template <typename Instrumentation>
+double run(const char* name, std::size_t npasses, double& sum)
+{
+  typename container_type<Instrumentation>::type container;
+  container.template get<long_tag>().assign(4096, 0.5);
+  container.template get<short_tag>().assign(16, 0.25);
+  container.template get<label_tag>() = "instrumentation";
+  container.template get<count_tag>() = 3;
+  container.template get<weight_tag>() = 1.5;
+
+  sum = 0.;
+  steady_clock::time_point refTime = steady_clock::now();
+  for (std::size_t pass = 0; pass < npasses; pass++) container.for_each(sum_level(sum));
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  double nsPerPass = (double)duration.count() / npasses;
+  std::cout << std::setw(8) << name << " " << std::setw(12) << std::fixed << std::setprecision(1) << nsPerPass
+            << std::endl;
+  return nsPerPass;
+}
+
+/// every level is called once per pass
+bool check_calls(const rc_timing_table& table, std::size_t nlevels, std::size_t npasses)
+{
+  bool ok = table.size() == nlevels;
+  for (std::size_t i = 0; ok && i < nlevels; i++) ok = table[i].calls == npasses;
+  return ok;
+}
+
+int main(int argc, char** argv)
+{
+  std::size_t npasses = argc > 1 ? std::atoll(argv[1]) : 100000;
+  const char* prefix = argc > 2 ? argv[2] : nullptr;
+
+  typedef rc_timing_instrumentation<rc_steady_clock> steady_instrumentation;
+  typedef rc_timing_instrumentation<rc_tsc_clock> tsc_instrumentation;
+  typedef container_type<tsc_instrumentation>::type tsc_container;
+
+  std::cout << std::setw(8) << "policy" << " " << std::setw(12) << "ns/pass" << std::endl;
+  double sumNone = 0., sumSteady = 0., sumTsc = 0.;
+  run<no_instrumentation>("none", npasses, sumNone);
+  run<steady_instrumentation>("steady", npasses, sumSteady);
+  run<tsc_instrumentation>("tsc", npasses, sumTsc);
+
+  const std::size_t nlevels = tsc_container().size();
+  rc_timing_table table = tsc_instrumentation::collect();
+  std::vector<std::string> names = rc_level_names<tsc_container>();
+  std::cout << std::endl;
+  rc_write_csv(std::cout, table, names);
+  std::cout << std::endl;
+  rc_write_collapsed(std::cout, table, "for_each", names);
+  if (prefix != nullptr) {
+    std::ofstream csv(std::string(prefix) + ".csv");
+    rc_write_csv(csv, table, names);
+    std::ofstream folded(std::string(prefix) + ".folded");
+    rc_write_collapsed(folded, table, "for_each", names);
+  }
+
+  bool ok = sumSteady == sumNone && sumTsc == sumNone && check_calls(table, nlevels, npasses) &&
+            check_calls(steady_instrumentation::collect(), nlevels, npasses);
+  std::cout << "results " << (ok ? "ok" : "failed") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_lazy_construction.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Construction cost of containers with eager and lazy levels
+///
+/// Containers of 4, 16 and 64 levels of type std::vector<double> are created
+/// with an initializer which fills every member with eight elements on
+/// construction. The same containers are created with lazy<> levels, the
+/// members are only constructed when they are accessed. In each container
+/// two levels are accessed after construction. The time per container is
+/// reported, the sums of the accessed levels are compared.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -I$BOOST_ROOT/include -o bench_lazy_construction bench_lazy_construction.cxx
+///
+/// Usage: bench_lazy_construction [ncontainers]
+///        ncontainers: number of containers per measurement, default 100000
+
+#include "runtime_container.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <numeric>
+#include <chrono>
+#include <cstdlib>
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/fold.hpp>
+#include <boost/mpl/push_back.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+typedef std::vector<double> Column;
+
+/// initializer filling a column with eight elements
+struct column_initializer {
+  template <typename T>
+  void operator()(T& v)
+  {
+    v = T();
+  }
+  void operator()(Column& v)
+  {
+    v.resize(8);
+    std::iota(v.begin(), v.end(), 0.);
+  }
+};
+
+template <int NLevels, typename Member>
+struct container_of {
+  typedef typename boost::mpl::fold<boost::mpl::range_c<int, 0, NLevels>, boost::mpl::vector<>,
+                                    boost::mpl::push_back<_1, Member>>::type types;
+  typedef typename create_rtc<types, RuntimeContainer<DefaultInterface, column_initializer>>::type type;
+};
+
+/// sum of the elements of a level
+struct sum_column {
+  typedef double return_type;
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    const Column& column = *stage;
+    return std::accumulate(column.begin(), column.end(), 0.);
+  }
+};
+
+template <typename ContainerT>
+double measure(int ncontainers, int nlevels, double& sum)
+{
+  steady_clock::time_point refTime = steady_clock::now();
+  for (int i = 0; i < ncontainers; i++) {
+    ContainerT container;
+    sum += container.apply(i % nlevels, sum_column());
+    sum += container.apply((i + nlevels / 2) % nlevels, sum_column());
+  }
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  return (double)duration.count() / ncontainers;
+}
+
+template <int NLevels>
+bool run(int ncontainers)
+{
+  double sumEager = 0., sumLazy = 0.;
+  double nsEager = measure<typename container_of<NLevels, Column>::type>(ncontainers, NLevels, sumEager);
+  double nsLazy = measure<typename container_of<NLevels, lazy<Column>>::type>(ncontainers, NLevels, sumLazy);
+  bool ok = sumEager == sumLazy;
+  std::cout << std::setw(8) << NLevels << " " << std::setw(12) << nsEager << " " << std::setw(12) << nsLazy << " "
+            << (ok ? "ok" : "failed") << std::endl;
+  return ok;
+}
+
+int main(int argc, char** argv)
+{
+  int ncontainers = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+  std::cout << std::setw(8) << "levels" << " " << std::setw(12) << "eager ns" << " " << std::setw(12) << "lazy ns"
+            << " check" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  bool ok = run<4>(ncontainers);
+  ok &= run<16>(ncontainers);
+  ok &= run<64>(ncontainers);
+
+  return ok ? 0 : 1;
+}
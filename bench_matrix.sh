@@ -0,0 +1,110 @@
+#!/bin/bash
+#****************************************************************************
+#* This file is free software: you can redistribute it and/or modify        *
+#* it under the terms of the GNU General Public License as published by     *
+#* the Free Software Foundation, either version 3 of the License, or        *
+#* (at your option) any later version.                                      *
+#*                                                                          *
+#* Primary Author(s): agent <agent@local>                                   *
+#*                                                                          *
+#* The authors make no claims about the suitability of this software for    *
+#* any purpose. It is provided "as is" without express or implied warranty. *
+#****************************************************************************
+
+# Benchmark matrix for the dispatch strategies
+#
+# Builds bench_runtime_container and compare_polymorphism for all combinations
+# of compiler (g++, clang++), optimization level (-O2, -O3), link time
+# optimization and profile guided optimization, runs them and prints one
+# markdown table with the time per dispatched call in ns.
+# Compilers which are not found are skipped.
+#
+# Usage: ./bench_matrix.sh [nrolls] [build directory]
+#   nrolls           iterations of the benchmark loops, default 10000000
+#   build directory  default ./bench-matrix
+#
+# Environment: COMPILERS, OPTLEVELS, LTO, PGO can be set to restrict the
+# matrix, e.g. COMPILERS="g++" OPTLEVELS="-O3" ./bench_matrix.sh
+
+set -e
+
+NROLLS=${1:-10000000}
+MATRIXDIR=${2:-$PWD/bench-matrix}
+SOURCEDIR=$(cd "$(dirname "$0")" && pwd)
+COMPILERS=${COMPILERS:-"g++ clang++"}
+OPTLEVELS=${OPTLEVELS:-"-O2 -O3"}
+LTO=${LTO:-"OFF ON"}
+PGO=${PGO:-"OFF ON"}
+TARGETS="bench_runtime_container compare_polymorphism"
+CP_MODES="virtual static bulk variant switch"
+# number of dispatched calls per iteration: four types in bench_runtime_container,
+# six types in compare_polymorphism
+NCALLS_RC=4
+NCALLS_CP=6
+
+# configure and build one configuration
+# build <dir> <compiler> <optlevel> <lto> <pgo mode>
+build() {
+  cmake -S "$SOURCEDIR" -B "$1" -DCMAKE_CXX_COMPILER="$2" -DCMAKE_BUILD_TYPE=Release \
+        -DCMAKE_CXX_FLAGS_RELEASE="$3 -DNDEBUG" -DGNERIC_ENABLE_LTO="$4" -DGNERIC_PGO="$5" \
+        > "$1.log" 2>&1
+  cmake --build "$1" -j"$(nproc)" --target $TARGETS >> "$1.log" 2>&1
+}
+
+# extract the ns of a compare_polymorphism mode and convert to ns/call
+cp_ns_per_call() {
+  "$1" "$NROLLS" "$2" | awk -v n="$NROLLS" -v c=$NCALLS_CP \
+    '/^testing/ {for (i = 1; i < NF; i++) if ($(i+1) == "ns") printf "%.3f", $i / (n * c)}'
+}
+
+# extract apply and unrolled apply from bench_runtime_container
+rc_ns_per_call() {
+  "$1" "$NROLLS" | awk -v n="$NROLLS" -v c=$NCALLS_RC \
+    '/^Type set/ {gsub(",", ""); split($0, f, ":"); split(f[2], t, " "); printf "%.3f %.3f", t[1] / (n * c), t[3] / (n * c)}'
+}
+
+mkdir -p "$MATRIXDIR"
+TABLE="$MATRIXDIR/results.md"
+{
+  echo "| compiler | opt | LTO | PGO | rc apply | rc unrolled | virtual | static poly | bulk | variant | switch |"
+  echo "|----------|-----|-----|-----|---------:|------------:|--------:|------------:|-----:|--------:|-------:|"
+} > "$TABLE"
+
+for compiler in $COMPILERS; do
+  if ! command -v "$compiler" > /dev/null; then
+    echo "compiler $compiler not found, skipping" >&2
+    continue
+  fi
+  for opt in $OPTLEVELS; do
+    for lto in $LTO; do
+      for pgo in $PGO; do
+        dir="$MATRIXDIR/$compiler$opt-lto$lto-pgo$pgo"
+        echo "building $dir" >&2
+        if [ "$pgo" = "ON" ]; then
+          rm -rf "$dir/pgo-profiles"
+          build "$dir" "$compiler" "$opt" "$lto" GENERATE
+          # training run with reduced number of iterations
+          for target in $TARGETS; do
+            (cd "$dir" && LLVM_PROFILE_FILE="$dir/pgo-profiles/%p.profraw" "./$target" $((NROLLS / 10 + 1)) > /dev/null)
+          done
+          if [[ "$compiler" == clang* ]]; then
+            llvm-profdata merge -o "$dir/pgo-profiles/default.profdata" "$dir"/pgo-profiles/*.profraw
+          fi
+          build "$dir" "$compiler" "$opt" "$lto" USE
+        else
+          build "$dir" "$compiler" "$opt" "$lto" OFF
+        fi
+        read -r rcapply rcunrolled <<< "$(rc_ns_per_call "$dir/bench_runtime_container")"
+        row="| $compiler | $opt | $lto | $pgo | $rcapply | $rcunrolled |"
+        for mode in $CP_MODES; do
+          row="$row $(cp_ns_per_call "$dir/compare_polymorphism" $mode) |"
+        done
+        echo "$row" >> "$TABLE"
+      done
+    done
+  done
+done
+
+echo
+echo "time per dispatched call in ns, $NROLLS iterations"
+cat "$TABLE"
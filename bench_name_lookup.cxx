@@ -0,0 +1,117 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_name_lookup.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Lookup of runtime container levels by name
+///
+/// A container with 16 named levels is addressed by a stream of names, one
+/// out of eight names is not a level name. The index lookup is compared for
+///  - hash:   compile time perfect hash of rc_name_index.h
+///  - map:    std::unordered_map<std::string, int>
+///  - linear: string compare with all level names
+/// The result is reported in ns per lookup.
+///
+/// Compilation:
+/// g++ --std=c++14 -O3 -I$BOOST_ROOT/include -o bench_name_lookup bench_name_lookup.cxx
+///
+/// Usage: bench_name_lookup [nrolls]
+///        nrolls: number of lookups, default 10000000
+
+#include "runtime_container.h"
+#include "rc_name_index.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/transform.hpp>
+#include <boost/mpl/back_inserter.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+constexpr const char* levelNames[] = {"energy",   "charge",   "momentum", "pt",     "eta",       "phi",
+                                      "mass",     "time",     "x",        "y",      "z",         "chi2",
+                                      "nclusters", "detector", "sector",   "quality"};
+const int nLevels = sizeof(levelNames) / sizeof(levelNames[0]);
+
+/// tag of level I, named from the table above
+template <typename I>
+struct level_tag {
+  static constexpr const char* name() { return levelNames[I::value]; }
+};
+template <typename I>
+struct make_level {
+  typedef tagged<level_tag<I>, float> type;
+};
+typedef boost::mpl::transform<boost::mpl::range_c<int, 0, nLevels>, make_level<boost::mpl::_1>,
+                              boost::mpl::back_inserter<boost::mpl::vector<>>>::type types;
+typedef create_rtc<types, RuntimeContainer<>>::type Container_t;
+
+template <typename F>
+double measure(const std::vector<std::string>& queries, int nrolls, long long& checksum, F f)
+{
+  steady_clock::time_point refTime = steady_clock::now();
+  for (int roll = 0; roll < nrolls; roll++) {
+    checksum += f(queries[roll % queries.size()]);
+  }
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  return (double)duration.count() / nrolls;
+}
+
+int main(int argc, char** argv)
+{
+  int nrolls = argc > 1 ? std::atoi(argv[1]) : 10000000;
+
+  // random stream of names, every eighth name is unknown
+  std::vector<std::string> queries;
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<int> distribution(0, nLevels - 1);
+  for (int i = 0; i < 1024; i++) {
+    queries.push_back(i % 8 == 7 ? std::string("unknown") : std::string(levelNames[distribution(generator)]));
+  }
+
+  std::unordered_map<std::string, int> map;
+  for (int index = 0; index < nLevels; index++) map[levelNames[index]] = index;
+
+  long long checksumHash = 0, checksumMap = 0, checksumLinear = 0;
+  double nsHash = measure(queries, nrolls, checksumHash,
+                          [](const std::string& name) { return rc_name_index<Container_t>::find(name); });
+  double nsMap = measure(queries, nrolls, checksumMap, [&map](const std::string& name) {
+    auto entry = map.find(name);
+    return entry != map.end() ? entry->second : -1;
+  });
+  double nsLinear = measure(queries, nrolls, checksumLinear, [](const std::string& name) {
+    for (int index = 0; index < nLevels; index++) {
+      if (name == levelNames[index]) return index;
+    }
+    return -1;
+  });
+
+  std::cout << std::setw(8) << "lookup" << " " << std::setw(10) << "ns/lookup" << std::endl;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << std::setw(8) << "hash" << " " << std::setw(10) << nsHash << std::endl;
+  std::cout << std::setw(8) << "map" << " " << std::setw(10) << nsMap << std::endl;
+  std::cout << std::setw(8) << "linear" << " " << std::setw(10) << nsLinear << std::endl;
+
+  bool ok = checksumHash == checksumMap && checksumHash == checksumLinear;
+  std::cout << "checksum " << checksumHash << (ok ? " ok" : " failed") << std::endl;
+  return ok ? 0 : 1;
+}
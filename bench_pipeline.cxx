@@ -0,0 +1,154 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_pipeline.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Multi-stage processing of a container stream
+///
+/// A stream of containers with 16 levels of type double passes the stages
+/// fill, transform, reduce and print. The stream is processed
+///  - passes:    one full pass over all containers per stage
+///  - tiled:     Pipeline::run_inline, all stages per batch on one thread
+///  - pipelined: Pipeline::run, one thread per stage
+/// The time per container and the counters of the pipeline stages are
+/// reported, the sums of the reduce stage are compared.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -pthread -I$BOOST_ROOT/include -o bench_pipeline bench_pipeline.cxx
+///
+/// Usage: bench_pipeline [ncontainers [batchsize]]
+///        ncontainers: length of the stream, default 1000000
+///        batchsize:   containers per batch, default 64
+
+#include "runtime_container.h"
+#include "rc_pipeline.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <chrono>
+#include <cstdlib>
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/fold.hpp>
+#include <boost/mpl/push_back.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+const int nLevels = 16;
+typedef boost::mpl::fold<boost::mpl::range_c<int, 0, nLevels>, boost::mpl::vector<>,
+                         boost::mpl::push_back<_1, double>>::type types;
+typedef create_rtc<types, RuntimeContainer<>>::type Container_t;
+
+/// fill stage: the levels of container index
+struct fill_levels {
+  typedef void return_type;
+  fill_levels(std::size_t index) : mIndex(index) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    stage = 0.001 * (mIndex % 1000) + T::level::value;
+  }
+  std::size_t mIndex;
+};
+
+/// transform stage
+struct transform_levels {
+  typedef void return_type;
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    stage = std::sqrt(*stage) * 1.5 + 0.25;
+  }
+};
+
+/// reduce stage: sum per level
+struct reduce_levels {
+  typedef void return_type;
+  reduce_levels(std::vector<double>& sums) : mSums(sums) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    mSums[T::level::value] += *stage;
+  }
+  std::vector<double>& mSums;
+};
+
+/// print stage: format the levels into a line buffer
+struct print_levels {
+  typedef void return_type;
+  print_levels(std::size_t& length) : mLength(length) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    char buffer[32];
+    mLength += std::snprintf(buffer, sizeof(buffer), " %.4f", *stage);
+  }
+  std::size_t& mLength;
+};
+
+template <typename F>
+double measure(std::size_t ncontainers, F f)
+{
+  steady_clock::time_point refTime = steady_clock::now();
+  f();
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  return (double)duration.count() / ncontainers;
+}
+
+int main(int argc, char** argv)
+{
+  std::size_t ncontainers = argc > 1 ? std::atoll(argv[1]) : 1000000;
+  std::size_t batchSize = argc > 2 ? std::atoll(argv[2]) : 64;
+
+  std::vector<double> sumsPasses(nLevels, 0.), sumsPipeline(nLevels, 0.);
+  std::size_t lengthPasses = 0, lengthPipeline = 0;
+  double nsPasses = measure(ncontainers, [&]() {
+    std::vector<Container_t> stream(ncontainers);
+    for (std::size_t i = 0; i < ncontainers; i++) stream[i].for_each(fill_levels(i));
+    for (auto& container : stream) container.for_each(transform_levels());
+    for (auto& container : stream) container.for_each(reduce_levels(sumsPasses));
+    for (auto& container : stream) container.for_each(print_levels(lengthPasses));
+  });
+
+  Pipeline<Container_t> pipeline(batchSize);
+  pipeline.add_container_stage("fill", [](Container_t& c, std::size_t index) { c.for_each(fill_levels(index)); });
+  pipeline.add_stage("transform", transform_levels());
+  pipeline.add_stage("reduce", reduce_levels(sumsPipeline));
+  pipeline.add_stage("print", print_levels(lengthPipeline));
+
+  double nsTiled = measure(ncontainers, [&]() { pipeline.run_inline(ncontainers); });
+  bool ok = sumsPipeline == sumsPasses && lengthPipeline == lengthPasses;
+  std::cout << "tiled, all stages on one thread:" << std::endl;
+  pipeline.print_stats(std::cout);
+
+  sumsPipeline.assign(nLevels, 0.);
+  lengthPipeline = 0;
+  pipeline.reset_stats();
+  double nsPipelined = measure(ncontainers, [&]() { pipeline.run(ncontainers); });
+  ok &= sumsPipeline == sumsPasses && lengthPipeline == lengthPasses;
+  std::cout << "pipelined, one thread per stage:" << std::endl;
+  pipeline.print_stats(std::cout);
+
+  std::cout << std::endl << std::setw(12) << "mode" << " " << std::setw(14) << "ns/container" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::setw(12) << "passes" << " " << std::setw(14) << nsPasses << std::endl;
+  std::cout << std::setw(12) << "tiled" << " " << std::setw(14) << nsTiled << std::endl;
+  std::cout << std::setw(12) << "pipelined" << " " << std::setw(14) << nsPipelined << std::endl;
+  std::cout << "results " << (ok ? "ok" : "failed") << std::endl;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_pool.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Per-event containers: construction against recycling from a pool
+///
+/// An event loop fills a container with two vectors, a string and two scalars
+/// per event. The container is either constructed and destroyed per event,
+/// or acquired from a ContainerPool and reset on release. The loop runs on
+/// 1 up to maxthreads threads sharing one pool, the time per event is
+/// reported together with the number of containers the pool constructed.
+/// The event checksums of both variants are compared.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -pthread -I$BOOST_ROOT/include -o bench_pool bench_pool.cxx
+///
+/// Usage: bench_pool [nevents [maxthreads]]
+///        nevents:    number of events per thread, default 1000000
+///        maxthreads: maximum number of threads, default 4
+
+#include "runtime_container.h"
+#include "rc_pool.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <boost/mpl/vector.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+struct hits_tag {
+  static const char* name() { return "hits"; }
+};
+struct samples_tag {
+  static const char* name() { return "samples"; }
+};
+struct label_tag {
+  static const char* name() { return "label"; }
+};
+typedef boost::mpl::vector<tagged<hits_tag, std::vector<double>>, tagged<samples_tag, std::vector<int>>,
+                           tagged<label_tag, std::string>, double, int>
+  types;
+typedef create_rtc<types, RuntimeContainer<>>::type Container_t;
+
+/// fill the container for an event and return a checksum
+double process(Container_t& container, int event)
+{
+  auto& hits = container.get<hits_tag>();
+  auto& samples = container.get<samples_tag>();
+  for (int i = 0; i < 32; i++) hits.push_back(event + 0.5 * i);
+  for (int i = 0; i < 64; i++) samples.push_back(event % 7 + i);
+  container.get<label_tag>() = "event number, long enough for the heap";
+  container.get<double>() = hits.size();
+  container.get<int>() = samples.size();
+  return hits.back() + samples.back() + container.get<label_tag>().size() + container.get<double>() +
+         container.get<int>();
+}
+
+template <typename F>
+double measure(int nevents, int nthreads, double& checksum, F event_loop)
+{
+  std::vector<double> sums(nthreads, 0.);
+  std::vector<std::thread> threads;
+  steady_clock::time_point refTime = steady_clock::now();
+  for (int t = 0; t < nthreads; t++) {
+    threads.emplace_back([&, t]() { sums[t] = event_loop(nevents); });
+  }
+  for (auto& thread : threads) thread.join();
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  for (auto sum : sums) checksum += sum;
+  return (double)duration.count() / ((double)nevents * nthreads);
+}
+
+int main(int argc, char** argv)
+{
+  int nevents = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  int maxthreads = argc > 2 ? std::atoi(argv[2]) : 4;
+
+  std::cout << std::setw(8) << "threads" << " " << std::setw(12) << "new ns" << " " << std::setw(12) << "pool ns"
+            << " " << std::setw(12) << "constructed" << " check" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+  bool failed = false;
+  for (int nthreads = 1; nthreads <= maxthreads; nthreads *= 2) {
+    double sumNew = 0., sumPool = 0.;
+    double nsNew = measure(nevents, nthreads, sumNew, [](int n) {
+      double sum = 0.;
+      for (int event = 0; event < n; event++) {
+        Container_t container;
+        sum += process(container, event);
+      }
+      return sum;
+    });
+    ContainerPool<Container_t> pool;
+    double nsPool = measure(nevents, nthreads, sumPool, [&pool](int n) {
+      double sum = 0.;
+      for (int event = 0; event < n; event++) {
+        auto container = pool.acquire();
+        sum += process(*container, event);
+      }
+      return sum;
+    });
+    bool ok = sumNew == sumPool;
+    failed |= !ok;
+    std::cout << std::setw(8) << nthreads << " " << std::setw(12) << nsNew << " " << std::setw(12) << nsPool << " "
+              << std::setw(12) << pool.constructed() << " " << (ok ? "ok" : "failed") << std::endl;
+  }
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,106 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_printer.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Cost of container dumps with the different printer policies
+///
+/// A container with eight levels is printed repeatedly with
+///  - verbose:  verbose_printer, stream output and flush per level
+///  - buffered: buffered_printer, one write and flush per container
+///  - async:    async_printer, formatting only, written by a background thread
+/// The dumps go to stdout, the timing to stderr. The time per print is measured
+/// on the calling thread, for the async printer also including the time until
+/// the writer has finished. Before the timing, the output of a short sequence
+/// is captured for all printers and compared, the program fails on a mismatch.
+///
+/// Compilation:
+/// g++ --std=c++17 -O3 -pthread -I$BOOST_ROOT/include -o bench_printer bench_printer.cxx
+///
+/// Usage: bench_printer [nprints] > /dev/null
+///        nprints: number of container dumps per printer, default 100000
+
+#include "runtime_container.h"
+#include "rc_printer.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <boost/mpl/vector.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+typedef boost::mpl::vector<int, float, double, long long, unsigned int, long, short, double> types;
+
+template <typename PrinterPolicy>
+struct container_with {
+  typedef typename create_rtc<types, RuntimeContainer<DefaultInterface, funny_initializer, PrinterPolicy>>::type type;
+};
+
+template <typename ContainerT>
+double measure(int nprints)
+{
+  ContainerT container;
+  steady_clock::time_point refTime = steady_clock::now();
+  for (int i = 0; i < nprints; i++) {
+    container.apply(i % 8, add_value<int>(1));
+    container.print();
+  }
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  return (double)duration.count() / nprints;
+}
+
+template <typename ContainerT>
+std::string capture(int nprints)
+{
+  std::ostringstream output;
+  std::streambuf* original = std::cout.rdbuf(output.rdbuf());
+  measure<ContainerT>(nprints);
+  async_printer::drain();
+  std::cout.rdbuf(original);
+  return output.str();
+}
+
+int main(int argc, char** argv)
+{
+  int nprints = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+  std::string expected = capture<container_with<verbose_printer>::type>(200);
+  if (expected.empty() || capture<container_with<buffered_printer>::type>(200) != expected ||
+      capture<container_with<async_printer>::type>(200) != expected || async_printer::dropped() != 0) {
+    std::cerr << "printer output mismatch" << std::endl;
+    return 1;
+  }
+
+  double nsVerbose = measure<container_with<verbose_printer>::type>(nprints);
+  double nsBuffered = measure<container_with<buffered_printer>::type>(nprints);
+  steady_clock::time_point refTime = steady_clock::now();
+  double nsAsync = measure<container_with<async_printer>::type>(nprints);
+  async_printer::drain();
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  double nsAsyncDrained = (double)duration.count() / nprints;
+
+  std::cerr << std::setw(16) << "printer" << " " << std::setw(10) << "ns/print" << std::endl;
+  std::cerr << std::fixed << std::setprecision(1);
+  std::cerr << std::setw(16) << "verbose" << " " << std::setw(10) << nsVerbose << std::endl;
+  std::cerr << std::setw(16) << "buffered" << " " << std::setw(10) << nsBuffered << std::endl;
+  std::cerr << std::setw(16) << "async" << " " << std::setw(10) << nsAsync << std::endl;
+  std::cerr << std::setw(16) << "async, drained" << " " << std::setw(10) << nsAsyncDrained << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,164 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_rc_move.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Copy and move accessors of runtime container levels with heavy members
+///
+/// The levels of the container wrap std::vector and std::string members. The
+/// following accessor pairs are measured for all levels with for_each
+///  - set copy:  set from a const reference, deep copy of the member
+///  - set move:  swap with a source container by take and set from rvalues, no copy
+///  - get copy:  read through the conversion to the wrapped type, deep copy
+///  - get ref:   read through the const reference returned by get
+///  - clone:     copy construction of the whole container
+///  - move:      move construction of the whole container
+/// The result is reported in ns per level and operation.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -I$BOOST_ROOT/include -o bench_rc_move bench_rc_move.cxx
+///
+/// Usage: bench_rc_move [nrolls [nelements]]
+///        nrolls:    number of iterations, default 100000
+///        nelements: number of elements of the members, default 1024
+
+#include "runtime_container.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <boost/mpl/vector.hpp>
+#include <boost/mpl/size.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+typedef boost::mpl::vector<std::vector<double>, std::string, std::vector<int>> types;
+typedef create_rtc<types, RuntimeContainer<>>::type Container_t;
+const int nLevels = boost::mpl::size<types>::value;
+
+/// fill the members with nelements elements
+struct fill_level {
+  typedef void return_type;
+  fill_level(std::size_t nelements) : mNElements(nelements) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    stage.emplace(mNElements, typename T::wrapped_type::value_type(1));
+  }
+  std::size_t mNElements;
+};
+
+/// set the level from the same level of a source container by copy
+struct set_copy {
+  typedef void return_type;
+  set_copy(const Container_t& source) : mSource(source) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    stage.set(*static_cast<const T&>(mSource));
+  }
+  const Container_t& mSource;
+};
+
+/// swap the members of the level and the source container by moves
+struct set_move {
+  typedef void return_type;
+  set_move(Container_t& source) : mSource(source) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    T& source = static_cast<T&>(mSource);
+    typename T::wrapped_type member = stage.take();
+    stage.set(source.take());
+    source.set(std::move(member));
+  }
+  Container_t& mSource;
+};
+
+/// read the member by the conversion operator, which copies
+struct get_copy {
+  typedef void return_type;
+  get_copy(std::size_t& count) : mCount(count) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    typename T::wrapped_type member = stage;
+    mCount += member.size();
+  }
+  std::size_t& mCount;
+};
+
+/// read the member by const reference
+struct get_ref {
+  typedef void return_type;
+  get_ref(std::size_t& count) : mCount(count) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    mCount += stage.get().size();
+  }
+  std::size_t& mCount;
+};
+
+template <typename F>
+double measure(int nrolls, F f)
+{
+  steady_clock::time_point refTime = steady_clock::now();
+  for (int roll = 0; roll < nrolls; roll++) {
+    f();
+  }
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  return (double)duration.count() / ((double)nrolls * nLevels);
+}
+
+void print_row(const char* name, double ns)
+{
+  std::cout << std::setw(10) << name << " " << std::setw(12) << std::fixed << std::setprecision(2) << ns << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  int nrolls = argc > 1 ? std::atoi(argv[1]) : 100000;
+  std::size_t nelements = argc > 2 ? std::atoll(argv[2]) : 1024;
+
+  Container_t container;
+  Container_t source;
+  source.for_each(fill_level(nelements));
+  std::size_t count = 0;
+
+  std::cout << std::setw(10) << "accessor" << " " << std::setw(12) << "ns/level" << std::endl;
+  print_row("set copy", measure(nrolls, [&]() { container.for_each(set_copy(source)); }));
+  print_row("set move", measure(nrolls, [&]() { container.for_each(set_move(source)); }));
+  print_row("get copy", measure(nrolls, [&]() { container.for_each(get_copy(count)); }));
+  print_row("get ref", measure(nrolls, [&]() { container.for_each(get_ref(count)); }));
+  print_row("clone", measure(nrolls, [&]() {
+              Container_t clone(container);
+              count += clone.get().size();
+            }));
+  print_row("move", measure(nrolls, [&]() {
+              Container_t moved(std::move(container));
+              container = std::move(moved);
+              count += container.get().size();
+            }));
+
+  // every get and the clone/move count the elements of the members
+  std::size_t expected = 2 * nrolls * nLevels * nelements + 2 * nrolls * nelements;
+  std::cout << "element count " << count << (count == expected ? " ok" : " failed") << std::endl;
+
+  return count == expected ? 0 : 1;
+}
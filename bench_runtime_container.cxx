@@ -1,8 +1,10 @@
 // g++ --std=c++11 -g -ggdb -I$BOOST_ROOT/include -o bench_runtime_container bench_runtime_container.cxx
+// usage: bench_runtime_container [nrolls]
 
 #include <iostream>
 #include <iomanip>
 #include <memory>
+#include <cstdlib>
 #include <boost/mpl/size.hpp>
 #include <boost/mpl/apply.hpp>
 #include <boost/mpl/int.hpp>
@@ -148,10 +150,11 @@ struct check_set {
 	      << std::endl;
 
     container.print();
+    return 0;
   }
 };
 
-int main() {
+int main(int argc, char** argv) {
   typedef boost::mpl::vector<
     int
     , char
@@ -159,6 +162,12 @@ int main() {
     , float
     > types;
 
+  if (argc > 1) {
+    // run only the specified number of iterations
+    check_set<types>::apply(std::atoi(argv[1]));
+    return 0;
+  }
+
   for (auto nrolls : {100, 1000, 10000, 100000, 1000000, 10000000, 100000000}) {
     for (auto factor : { 1, 2, 4, 6, 8}) {
       check_set<types>::apply(nrolls*factor);
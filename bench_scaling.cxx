@@ -0,0 +1,215 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_scaling.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Scaling of the dispatch strategies with container width and member size
+///
+/// The benchmark suite is generated at compile time for all combinations of
+/// container width (2 to 128 levels) and member type (int, 64 byte struct,
+/// std::array<double, 16>). For every combination the following dispatch
+/// strategies are measured
+///  - virtual: vector of pointers to objects with virtual interface
+///  - apply:   runtime container, generic apply per level
+///  - bulk:    runtime container, for_each over all levels
+/// Every operation increments all words of the member of one level. The result
+/// is reported as ns/op and bytes/op, the latter being the memory footprint
+/// per level of the data structure including pointers and vptr.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -I$BOOST_ROOT/include -o bench_scaling bench_scaling.cxx
+///
+/// Usage: bench_scaling [nops]
+///        nops: number of operations per measurement, default 20000000
+
+#include "runtime_container.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <boost/mpl/vector.hpp>
+#include <boost/mpl/vector_c.hpp>
+#include <boost/mpl/fold.hpp>
+#include <boost/mpl/push_back.hpp>
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/for_each.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+/// a member of 64 bytes
+struct Block64 {
+  Block64() : words() {}
+  uint64_t words[8];
+};
+typedef std::array<double, 16> Array16;
+
+/// the operation: increment all words of the member
+inline void bump(int& v) { v += 1; }
+inline void bump(Block64& v) {
+  for (auto& word : v.words) word += 1;
+}
+inline void bump(Array16& v) {
+  for (auto& element : v) element += 1.;
+}
+inline double checksum(const int& v) { return v; }
+inline double checksum(const Block64& v) { return v.words[0]; }
+inline double checksum(const Array16& v) { return v[0]; }
+
+const char* payload_name(int*) { return "int"; }
+const char* payload_name(Block64*) { return "Block64"; }
+const char* payload_name(Array16*) { return "array<double,16>"; }
+
+/**
+ * @brief Virtual interface for the runtime polymorphic strategy
+ */
+class Interface {
+public:
+  virtual ~Interface() {}
+  virtual void bump() = 0;
+  virtual double checksum() const = 0;
+};
+
+template<typename Payload>
+class Level : public Interface {
+public:
+  Level() : mPayload() {}
+  void bump() { ::bump(mPayload); }
+  double checksum() const { return ::checksum(mPayload); }
+private:
+  Payload mPayload;
+};
+
+/// functor for the runtime container levels
+struct bump_level {
+  typedef void return_type;
+  template<typename T>
+  return_type operator()(T& stage) { bump(*stage); }
+};
+
+struct checksum_level {
+  typedef void return_type;
+  checksum_level(double& sum) : mSum(sum) {}
+  template<typename T>
+  return_type operator()(T& stage) { mSum += checksum(*stage); }
+  double& mSum;
+};
+
+/// generate a type list with Width copies of the payload type
+template<typename Payload, int Width>
+struct make_types {
+  typedef typename boost::mpl::fold<
+    boost::mpl::range_c<int, 0, Width>,
+    boost::mpl::vector<>,
+    boost::mpl::push_back<_1, Payload>
+    >::type type;
+};
+
+/// memory barrier for the compiler, otherwise the increments of all
+/// iterations are merged into one operation
+inline void clobber_memory()
+{
+#ifdef __GNUC__
+  asm volatile("" : : : "memory");
+#endif
+}
+
+template<typename F>
+double measure(long long nops, int width, F f)
+{
+  // at least one roll, also if there are fewer operations than levels
+  long long nrolls = std::max(nops / width, 1LL);
+  steady_clock::time_point refTime = steady_clock::now();
+  for (long long roll = 0; roll < nrolls; roll++) {
+    f();
+    clobber_memory();
+  }
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  return (double)duration.count() / (nrolls * width);
+}
+
+void print_row(int width, const char* payload, const char* strategy, double nsPerOp, double bytesPerOp)
+{
+  std::cout << std::setw(6) << width << " "
+            << std::setw(18) << payload << " "
+            << std::setw(8) << strategy << " "
+            << std::setw(10) << std::fixed << std::setprecision(3) << nsPerOp << " "
+            << std::setw(10) << std::setprecision(1) << bytesPerOp
+            << std::endl;
+}
+
+/// run all strategies for one width and payload
+template<typename Payload>
+struct run_width {
+  run_width(long long nops, double& sum) : mNops(nops), mSum(sum) {}
+
+  template<typename WidthT>
+  void operator()(WidthT) {
+    const int width = WidthT::value;
+    typedef typename make_types<Payload, width>::type types;
+    typedef typename create_rtc<types, RuntimeContainer<> >::type Container_t;
+    const char* name = payload_name((Payload*)nullptr);
+
+    std::vector<Interface*> objects;
+    for (int i = 0; i < width; i++) objects.push_back(new Level<Payload>);
+    double nsVirtual = measure(mNops, width, [&]() {
+      for (auto object : objects) object->bump();
+    });
+    for (auto object : objects) {
+      mSum += object->checksum();
+      delete object;
+    }
+    print_row(width, name, "virtual", nsVirtual, sizeof(Interface*) + sizeof(Level<Payload>));
+
+    Container_t container;
+    double nsApply = measure(mNops, width, [&]() {
+      for (int index = 0; index < width; index++) container.apply(index, bump_level());
+    });
+    print_row(width, name, "apply", nsApply, (double)sizeof(Container_t) / width);
+
+    double nsBulk = measure(mNops, width, [&]() { container.for_each(bump_level()); });
+    print_row(width, name, "bulk", nsBulk, (double)sizeof(Container_t) / width);
+    container.for_each(checksum_level(mSum));
+  }
+
+  long long mNops;
+  double& mSum;
+};
+
+typedef boost::mpl::vector_c<int, 2, 4, 8, 16, 32, 64, 128> widths;
+
+int main(int argc, char** argv)
+{
+  long long nops = argc > 1 ? std::atoll(argv[1]) : 20000000;
+
+  std::cout << std::setw(6) << "width" << " "
+            << std::setw(18) << "member" << " "
+            << std::setw(8) << "strategy" << " "
+            << std::setw(10) << "ns/op" << " "
+            << std::setw(10) << "bytes/op"
+            << std::endl;
+  // the checksum keeps the compiler from dropping the operations
+  double sum = 0.;
+  boost::mpl::for_each<widths>(run_width<int>(nops, sum));
+  boost::mpl::for_each<widths>(run_width<Block64>(nops, sum));
+  boost::mpl::for_each<widths>(run_width<Array16>(nops, sum));
+  std::cout << "checksum " << std::setprecision(0) << sum << std::endl;
+
+  return 0;
+}
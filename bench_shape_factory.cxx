@@ -0,0 +1,150 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_shape_factory.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Containers with a runtime selection of the levels
+///
+/// The master type list has 8 levels. A job uses the levels selected by the
+/// shape mask, the containers are filled and the levels are summed. The time
+/// per container is measured
+///  - full:        container with all master types, the unused levels exist
+///  - static:      container of the shape selected at compile time
+///  - batch:       rc_shape_factory handle, one virtual call per batch
+///  - per element: the handle of a batch with one container, one virtual
+///                 call per container
+/// The size of the containers is reported, the sums of the modes with the
+/// shape are compared. The static mode uses the default shape.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -pthread -I$BOOST_ROOT/include -o bench_shape_factory bench_shape_factory.cxx
+///
+/// Usage: bench_shape_factory [ncontainers [shape]]
+///        ncontainers: containers per batch, default 1000000
+///        shape:       mask of the selected levels, default 0x15
+
+#include "runtime_container.h"
+#include "rc_shape_factory.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <boost/mpl/vector.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+typedef boost::mpl::vector<double, float, int, long, short, unsigned, long double, char> types;
+const std::uint64_t defaultShape = 0x15;
+
+/// fill a level from the index of the container
+struct fill_level {
+  typedef void return_type;
+  fill_level(std::size_t index) : mIndex(index) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    stage = (typename T::wrapped_type)((mIndex + T::level::value) % 100);
+  }
+  std::size_t mIndex;
+};
+
+/// sum of all levels
+struct sum_level {
+  typedef void return_type;
+  sum_level(double& sum) : mSum(sum) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    mSum += *stage;
+  }
+  double& mSum;
+};
+
+/// batch operation: fill and sum all containers
+struct fill_and_sum {
+  double sum = 0.;
+  template <typename ContainerT>
+  void operator()(std::vector<ContainerT>& containers, std::uint64_t /*shape*/)
+  {
+    for (std::size_t i = 0; i < containers.size(); i++) containers[i].for_each(fill_level(i + mOffset));
+    for (auto& container : containers) container.for_each(sum_level(sum));
+  }
+  std::size_t mOffset = 0;
+};
+
+typedef rc_shape_factory<types, RuntimeContainer<>, fill_and_sum> factory;
+
+template <typename F>
+double measure(std::size_t ncontainers, F f)
+{
+  steady_clock::time_point refTime = steady_clock::now();
+  f();
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  return (double)duration.count() / ncontainers;
+}
+
+void print(const char* mode, double ns)
+{
+  std::cout << std::setw(12) << mode << " " << std::setw(14) << std::fixed << std::setprecision(2) << ns << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  std::size_t ncontainers = argc > 1 ? std::atoll(argv[1]) : 1000000;
+  std::uint64_t shape = argc > 2 ? std::strtoull(argv[2], nullptr, 0) : defaultShape;
+  shape &= factory::full_shape();
+
+  std::cout << "shape 0x" << std::hex << shape << std::dec << std::endl;
+  typedef factory::container<factory::full_shape()>::type full_container;
+  typedef factory::container<defaultShape>::type static_container;
+  std::cout << "container size: full " << sizeof(full_container) << " bytes, default shape " << sizeof(static_container)
+            << " bytes" << std::endl;
+  std::cout << std::setw(12) << "mode" << " " << std::setw(14) << "ns/container" << std::endl;
+
+  std::vector<full_container> full(ncontainers);
+  fill_and_sum fullOp;
+  print("full", measure(ncontainers, [&]() { fullOp(full, factory::full_shape()); }));
+
+  bool ok = true;
+  fill_and_sum batchOp;
+  factory::handle batch = factory::create(shape);
+  batch->resize(ncontainers);
+  double nsBatch = measure(ncontainers, [&]() { batch->accept(batchOp); });
+
+  if (shape == defaultShape) {
+    std::vector<static_container> selected(ncontainers);
+    fill_and_sum staticOp;
+    print("static", measure(ncontainers, [&]() { staticOp(selected, defaultShape); }));
+    ok &= staticOp.sum == batchOp.sum;
+  }
+  print("batch", nsBatch);
+
+  fill_and_sum elementOp;
+  factory::handle element = factory::create(shape);
+  element->resize(1);
+  print("per element", measure(ncontainers, [&]() {
+          for (std::size_t i = 0; i < ncontainers; i++) {
+            elementOp.mOffset = i;
+            element->accept(elementOp);
+          }
+        }));
+  ok &= elementOp.sum == batchOp.sum;
+
+  std::cout << "levels " << batch->levels() << " of " << factory::nTypes << std::endl;
+  std::cout << "results " << (ok ? "ok" : "failed") << std::endl;
+  return ok ? 0 : 1;
+}
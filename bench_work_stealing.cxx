@@ -0,0 +1,149 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   bench_work_stealing.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Load balance of uneven per-level work: static partitioning and work stealing
+///
+/// A container holds statistics distributions like in multiple_distributions
+/// and plain integer and floating point levels. The same number of items is
+/// processed for every level: a sample is drawn from the distribution levels,
+/// the plain levels only add a number. The cost per item differs by orders
+/// of magnitude. The chunks of all levels are processed with
+/// rc_work_stealing_scheduler with and without stealing. The time, and the
+/// busy time and executed chunks of every worker are reported, the imbalance
+/// is the maximum over the mean busy time. The chunk results do not depend on
+/// the worker, the sums of both modes are compared.
+///
+/// Compilation:
+/// g++ --std=c++11 -O3 -pthread -I$BOOST_ROOT/include -o bench_work_stealing bench_work_stealing.cxx
+///
+/// Usage: bench_work_stealing [nitems [nworkers [chunksize]]]
+///        nitems:    items per level, default 1000000
+///        nworkers:  number of workers, default 4
+///        chunksize: items per chunk, default 4096
+
+#include "runtime_container.h"
+#include "rc_work_stealing.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <type_traits>
+#include <chrono>
+#include <cstdlib>
+#include <boost/mpl/vector.hpp>
+
+using namespace gNeric;
+
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::milliseconds TimeScale;
+
+typedef boost::mpl::vector<std::gamma_distribution<double>, std::normal_distribution<double>,
+                           std::poisson_distribution<int>, std::lognormal_distribution<double>, int, double, long, float>
+  types;
+typedef create_rtc<types, RuntimeContainer<>>::type Container_t;
+
+/// process the items of a chunk, one result per chunk
+class sample_chunk
+{
+ public:
+  typedef void return_type;
+  sample_chunk(std::vector<std::vector<double>>& results, std::size_t chunkSize)
+    : mResults(results), mChunkSize(chunkSize)
+  {
+  }
+
+  template <typename T>
+  return_type operator()(T& stage, std::size_t begin, std::size_t end)
+  {
+    double sum = process(*stage, T::level::value, begin, end, std::is_arithmetic<typename T::wrapped_type>());
+    mResults[T::level::value][begin / mChunkSize] = sum;
+  }
+
+ private:
+  /// distribution levels: sample with an engine seeded by level and chunk
+  template <typename D>
+  static double process(const D& member, int level, std::size_t begin, std::size_t end, std::false_type)
+  {
+    std::mt19937 engine(level * 1000003 + begin);
+    D distribution(member.param());
+    double sum = 0.;
+    for (std::size_t i = begin; i < end; i++) sum += distribution(engine);
+    return sum;
+  }
+  /// plain levels: add numbers
+  template <typename V>
+  static double process(const V& member, int, std::size_t begin, std::size_t end, std::true_type)
+  {
+    V sum = member;
+    for (std::size_t i = begin; i < end; i++) sum += (V)(i & 0xf);
+    return sum;
+  }
+
+  std::vector<std::vector<double>>& mResults;
+  std::size_t mChunkSize;
+};
+
+double run(Container_t& container, bool steal, std::size_t nworkers, std::size_t nitems, std::size_t chunkSize,
+           double& total)
+{
+  const std::size_t nchunks = (nitems + chunkSize - 1) / chunkSize;
+  std::vector<std::vector<double>> results(container.size(), std::vector<double>(nchunks, 0.));
+  rc_work_stealing_scheduler scheduler(nworkers, steal);
+  steady_clock::time_point refTime = steady_clock::now();
+  scheduler.for_each_chunked(container, sample_chunk(results, chunkSize), nitems, chunkSize);
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+
+  double maxBusy = 0., sumBusy = 0.;
+  std::cout << (steal ? "work stealing:" : "static partitioning:") << std::endl;
+  std::cout << std::setw(8) << "worker" << " " << std::setw(10) << "busy/ms" << " " << std::setw(8) << "chunks" << " "
+            << std::setw(8) << "stolen" << std::endl;
+  for (std::size_t w = 0; w < scheduler.size(); w++) {
+    const rc_worker_stats& stats = scheduler.stats()[w];
+    std::cout << std::setw(8) << w << " " << std::setw(10) << std::fixed << std::setprecision(1)
+              << 1e3 * stats.busyTime << " " << std::setw(8) << stats.executed << " " << std::setw(8) << stats.stolen
+              << std::endl;
+    maxBusy = std::max(maxBusy, stats.busyTime);
+    sumBusy += stats.busyTime;
+  }
+  std::cout << "  time " << duration.count() << " ms, imbalance " << std::setprecision(2)
+            << maxBusy * scheduler.size() / sumBusy << std::endl;
+
+  total = 0.;
+  for (auto& level : results) total = std::accumulate(level.begin(), level.end(), total);
+  return duration.count();
+}
+
+int main(int argc, char** argv)
+{
+  std::size_t nitems = argc > 1 ? std::atoll(argv[1]) : 1000000;
+  std::size_t nworkers = argc > 2 ? std::atoll(argv[2]) : 4;
+  std::size_t chunkSize = argc > 3 ? std::atoll(argv[3]) : 4096;
+
+  Container_t container;
+  container.get<std::gamma_distribution<double>>() = std::gamma_distribution<double>(2., 2.);
+  container.get<std::normal_distribution<double>>() = std::normal_distribution<double>(5., 2.);
+  container.get<std::poisson_distribution<int>>() = std::poisson_distribution<int>(40.);
+  container.get<std::lognormal_distribution<double>>() = std::lognormal_distribution<double>(0., 0.5);
+
+  double totalStatic = 0., totalStealing = 0.;
+  run(container, false, nworkers, nitems, chunkSize, totalStatic);
+  run(container, true, nworkers, nitems, chunkSize, totalStealing);
+
+  bool ok = totalStatic == totalStealing;
+  std::cout << "results " << (ok ? "ok" : "failed") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -22,114 +22,72 @@
 /// The static polymorphic case uses the runtime container for the runtime
 /// state of all types from the list. This example uses the generic apply
 /// method for dispatch to the individual object.
+/// For comparison with the standard library, the objects are stored in a
+/// vector of std::variant and processed with std::visit, and with a hand
+/// written switch on the variant index.
+///
+/// All modes are run by the same driver with the same number of iterations,
+/// the final state of the objects is verified against the first mode.
 
 /// Compilation:
-/// g++ --std=c++11 -O3 -I$BOOST_ROOT/include -o compare_polymorphism compare_polymorphism.cxx
+/// g++ --std=c++17 -O3 -I$BOOST_ROOT/include -o compare_polymorphism compare_polymorphism.cxx
 /// Options: -DNROLLS=number  default is 1000000000
-///          -DSTATIC_POLY    select static polymorphism (default runtime)
-///          -DBULK_OPERATION select static polymorphism with bulk operation
+///          -DSTATIC_POLY    select static polymorphism as default mode
+///          -DBULK_OPERATION select static polymorphism with bulk operation as default mode
+/// The variant modes require C++17, with C++11 they are not available.
 /// debug options: replace -O3 by e.g. '-g -ggdb'
+///
+/// Usage: compare_polymorphism [nrolls [mode...]]
+///        modes: virtual static bulk variant switch, default all
 
 #include "runtime_container.h"
+#include "type_wrapper.h"
 #include <iostream>
 #include <iomanip>
 #include <memory>
 #include <vector>
+#include <string>
 #include <type_traits>
 #include <chrono>
+#include <cstdlib>
+#include <algorithm>
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/for_each.hpp>
 #include <boost/mpl/at.hpp>
+#include <boost/mpl/transform.hpp>
+#if __cplusplus >= 201703L
+#include <variant>
+#endif
 
 using namespace gNeric;
 
 typedef std::chrono::system_clock system_clock;
 typedef std::chrono::nanoseconds TimeScale;
 
-#if defined(BULK_OPERATION) and not defined(STATIC_POLY)
-#define STATIC_POLY
-#endif
-
-#ifdef STATIC_POLY
-#define VIRTUAL_ATTRIBUTE
-#define PURE_VIRTUAL_ATTRIBUTE {}
-#else
-#define VIRTUAL_ATTRIBUTE virtual
-#define PURE_VIRTUAL_ATTRIBUTE = 0
-#endif
-
-/**
- * @brief Common interface for type wrappers
- * This is a pure virtual interface class for the runtime polymorphic
- * case and not needed for the static polymorphic case.
- */
-class Interface {
-public:
-  typedef Interface self_type;
-
-  Interface() {}
-  VIRTUAL_ATTRIBUTE ~Interface() {}
-
-  VIRTUAL_ATTRIBUTE void print() const PURE_VIRTUAL_ATTRIBUTE;
-  VIRTUAL_ATTRIBUTE self_type& operator+=(int value) PURE_VIRTUAL_ATTRIBUTE;
-
-private:
-};
-
-/**
- * @brief Wrapper class to test the virtual interface
- * The class can wrap an arbitrary type which implements operator++ and
- * the output stream operator.
- */
-template<typename T>
-class TypeWrapper : public Interface {
-public:
-  typedef TypeWrapper self_type;
-  typedef T wrapped_type;
-
-  TypeWrapper() : mMember(0), mCount(0) {}
-  VIRTUAL_ATTRIBUTE ~TypeWrapper() {}
-
-  VIRTUAL_ATTRIBUTE void print() const {
-    const char* typeName = "unknown";
-    if (std::is_floating_point<wrapped_type>::value)
-      typeName = "float";
-    if (std::is_integral<wrapped_type>::value) {
-      if (std::is_signed<wrapped_type>::value)
-        typeName = "signed int";
-      else
-        typeName = "unsigned int";
-    }
-
-    std::cout << "I'm a "
-              << std::setw(12) << typeName << " type,"
-              << " of size " << sizeof(wrapped_type)
-              << " value " << std::setw(10) << std::setprecision(4) << mMember
-              << "  - called " << std::setw(10) << mCount << " time(s)"
-              << std::endl;
-  }
-
-  VIRTUAL_ATTRIBUTE self_type& operator+=(int value) {
-    mMember += value;
-    ++mCount;
-  }
-
-private:
-  T mMember;
-  int mCount;
-};
-
 /**
  * @brief Definition of the data types to be used in the test
  */
 typedef boost::mpl::vector<
-  TypeWrapper<int>
-  ,TypeWrapper<float>
-  ,TypeWrapper<short>
-  ,TypeWrapper<double>
-  ,TypeWrapper<char>
-  ,TypeWrapper<uint64_t>
-  > types;
+  int
+  ,float
+  ,short
+  ,double
+  ,char
+  ,uint64_t
+  > wrapped_types;
+
+/// wrappers with virtual interface for the runtime polymorphic case
+typedef boost::mpl::transform<wrapped_types, TypeWrapper<_1, Interface> >::type types;
+/// wrappers without interface for the static polymorphic cases
+typedef boost::mpl::transform<wrapped_types, TypeWrapper<_1, NoInterface> >::type static_types;
+
+/// state of one object after the test loop, used for results verification
+struct Result {
+  double value;
+  int count;
+  bool operator!=(const Result& other) const { return value != other.value || count != other.count; }
+};
+typedef std::vector<Result> Results;
 
 // TODO:
 // - this should be in general included in runtime_container.h
@@ -144,6 +102,19 @@ struct printer
   return_type operator()(T& me) {return (*me).print();}
 };
 
+/// collect the state of the objects
+struct collector
+{
+  collector(Results& results) : mResults(results) {}
+  typedef void return_type;
+  template<typename T>
+  return_type operator()(T& me) {
+    Result result = {(*me).value(), (*me).count()};
+    mResults.push_back(result);
+  }
+  Results& mResults;
+};
+
 /**
  * @brief Unary increment functor for bulk operation
  * This test is probably a bit artificial, all the members are simply
@@ -165,94 +136,290 @@ struct increment
 };
 
 /**
- * @brief The test loop
+ * @brief Unary function for mpl for_each loop to add pointer of new object
+ * Create an object of the corresponding type. The type comes from the list
+ * of types while for_each is going through the list.
  *
- * TODO: the ifdef's are a bit ugly but the simple testing approach justifies
- * the means.
+ * TODO:that would be probably suited for a templated lambda function, but
+ * this is only supported from C++14, look into this at some time
  */
 template<typename ContainerT>
-int test_loop(ContainerT& container, int nrolls) {
+struct add_object {
+  add_object(ContainerT& c) : _c(c) {};
+  template<typename T>
+  void operator()(T&) {
+    _c.push_back(new T);
+  }
 
-  system_clock::time_point refTime = system_clock::now();
-  auto functor = add_value<int>(1);
-  for (auto roll = 0; roll < nrolls; roll++) {
-#if defined(STATIC_POLY) and defined(BULK_OPERATION)
-    boost::mpl::for_each<typename ContainerT::types>(increment<ContainerT>(container));
-#else
-    for (auto index = 0; index < container.size(); index++) {
-#ifdef STATIC_POLY
-      container.apply(index, functor);
-#else
-      *(container[index])+=1;
-#endif
+  ContainerT& _c;
+};
+
+/**
+ * @brief Runtime polymorphism: vector of pointers and virtual calls
+ */
+class VirtualMode {
+public:
+  static const char* name() { return "virtual"; }
+  static const char* description() { return "runtime polymorphic"; }
+
+  VirtualMode() : mContainer() {
+    boost::mpl::for_each<types>(add_object<std::vector<Interface*> >(mContainer));
+  }
+  ~VirtualMode() {
+    for (auto element : mContainer) {
+      delete element;
+    }
+  }
+
+  void run(int nrolls) {
+    for (auto roll = 0; roll < nrolls; roll++) {
+      for (std::size_t index = 0; index < mContainer.size(); index++) {
+        *(mContainer[index])+=1;
+      }
+    }
+  }
+
+  void collect(Results& results) const {
+    for (auto element : mContainer) {
+      Result result = {element->value(), element->count()};
+      results.push_back(result);
+    }
+  }
+
+  void print() const {
+    for (auto& element : mContainer) {
+      element->print();
+    }
+  }
+
+private:
+  std::vector<Interface*> mContainer;
+};
+
+/**
+ * @brief Static polymorphism: runtime container and generic apply
+ */
+class StaticMode {
+public:
+  typedef create_rtc< static_types, RuntimeContainer<> >::type Container_t;
+  static const char* name() { return "static"; }
+  static const char* description() { return "static polymorphic"; }
+
+  void run(int nrolls) {
+    auto functor = add_value<int>(1);
+    for (auto roll = 0; roll < nrolls; roll++) {
+      for (std::size_t index = 0; index < mContainer.size(); index++) {
+        mContainer.apply(index, functor);
+      }
+    }
+  }
+
+  void collect(Results& results) {
+    mContainer.for_each(collector(results));
+  }
+
+  void print() {
+    for (std::size_t index = 0; index < mContainer.size(); index++) {
+      mContainer.apply(index, printer());
     }
-#endif
   }
+
+protected:
+  Container_t mContainer;
+};
+
+/**
+ * @brief Static polymorphism: runtime container and bulk operation
+ */
+class BulkMode : public StaticMode {
+public:
+  static const char* name() { return "bulk"; }
+  static const char* description() { return "static polymorphic bulk operation"; }
+
+  void run(int nrolls) {
+    for (auto roll = 0; roll < nrolls; roll++) {
+      boost::mpl::for_each<Container_t::types>(increment<Container_t>(mContainer));
+    }
+  }
+};
+
+#if __cplusplus >= 201703L
+/// convert an mpl sequence into a std::variant
+template<typename Iterator, typename End, typename... Ts>
+struct make_variant {
+  typedef typename make_variant<typename boost::mpl::next<Iterator>::type, End, Ts...,
+                                typename boost::mpl::deref<Iterator>::type>::type type;
+};
+template<typename End, typename... Ts>
+struct make_variant<End, End, Ts...> {
+  typedef std::variant<Ts...> type;
+};
+typedef make_variant<boost::mpl::begin<static_types>::type, boost::mpl::end<static_types>::type>::type Variant_t;
+
+/**
+ * @brief Standard library: vector of std::variant and std::visit
+ */
+class VariantMode {
+public:
+  static const char* name() { return "variant"; }
+  static const char* description() { return "variant visit"; }
+
+  VariantMode() : mContainer() {
+    boost::mpl::for_each<static_types>(add_variant(mContainer));
+  }
+
+  void run(int nrolls) {
+    for (auto roll = 0; roll < nrolls; roll++) {
+      for (std::size_t index = 0; index < mContainer.size(); index++) {
+        std::visit([](auto& element) { element += 1; }, mContainer[index]);
+      }
+    }
+  }
+
+  void collect(Results& results) const {
+    for (auto& element : mContainer) {
+      std::visit([&results](auto& e) { results.push_back(Result{e.value(), e.count()}); }, element);
+    }
+  }
+
+  void print() const {
+    for (auto& element : mContainer) {
+      std::visit([](auto& e) { e.print(); }, element);
+    }
+  }
+
+protected:
+  struct add_variant {
+    add_variant(std::vector<Variant_t>& c) : _c(c) {}
+    template<typename T>
+    void operator()(T& t) {
+      _c.push_back(Variant_t(t));
+    }
+    std::vector<Variant_t>& _c;
+  };
+
+  std::vector<Variant_t> mContainer;
+};
+
+/**
+ * @brief Hand written switch on the type tag, i.e. the variant index
+ */
+class SwitchMode : public VariantMode {
+public:
+  static const char* name() { return "switch"; }
+  static const char* description() { return "switch on tag"; }
+
+  void run(int nrolls) {
+    for (auto roll = 0; roll < nrolls; roll++) {
+      for (std::size_t index = 0; index < mContainer.size(); index++) {
+        Variant_t& element = mContainer[index];
+        switch (element.index()) {
+          case 0: *std::get_if<0>(&element) += 1; break;
+          case 1: *std::get_if<1>(&element) += 1; break;
+          case 2: *std::get_if<2>(&element) += 1; break;
+          case 3: *std::get_if<3>(&element) += 1; break;
+          case 4: *std::get_if<4>(&element) += 1; break;
+          case 5: *std::get_if<5>(&element) += 1; break;
+        }
+      }
+    }
+  }
+};
+static_assert(std::variant_size<Variant_t>::value == 6, "the switch needs to be adjusted to the list of types");
+#endif
+
+/**
+ * @brief The test driver
+ * Runs the test loop of a mode, measures the wall time and verifies the
+ * final state of the objects against the reference. The first mode
+ * provides the reference.
+ */
+template<typename Mode>
+int test_loop(int nrolls, Results& reference) {
+  Mode container;
+
+  system_clock::time_point refTime = system_clock::now();
+  container.run(nrolls);
   auto duration = std::chrono::duration_cast<TimeScale>(system_clock::now() - refTime);
 
   std::cout << "testing "
-#ifdef STATIC_POLY
-#ifdef BULK_OPERATION
-	    << "static polymorphic bulk operation "
-#else
-	    << "static polymorphic "
-#endif
-#else
-	    << "runtime polymorphic "
-#endif
+	    << Mode::description() << " "
 	    << "container with "
             << std::setw(10) << nrolls << " iteration(s): "
             << std::setw(10) << duration.count() << " ns"
             << std::endl;
 
-#ifdef STATIC_POLY
-  for (auto index = 0; index < container.size(); index++) {
-    container.apply(index, printer());
+  container.print();
+
+  Results results;
+  container.collect(results);
+  if (reference.empty()) {
+    reference = results;
   }
-#else
-  for (auto& element : container) {
-    element->print();
+  bool mismatch = results.size() != reference.size();
+  for (std::size_t index = 0; !mismatch && index < results.size(); index++) {
+    mismatch = results[index] != reference[index] || results[index].count != nrolls;
+  }
+  if (mismatch) {
+    std::cerr << "results verification failed for mode '" << Mode::name() << "'" << std::endl;
+    return 1;
   }
-#endif
 
   return 0;
 }
 
-/**
- * @brief Unary function for mpl for_each loop to add pointer of new object
- * Create an object of the corresponding type. The type comes from the list
- * of types while for_each is going through the list.
- *
- * TODO:that would be probably suited for a templated lambda function, but
- * this is only supported from C++14, look into this at some time
- */
-template<typename ContainerT>
-struct add_object {
-  add_object(ContainerT& c) : _c(c) {};
-  template<typename T>
-  void operator()(T&) {
-    _c.push_back(new T);
+template<typename Mode>
+bool select_mode(const std::vector<std::string>& modes) {
+  for (auto& mode : modes) {
+    if (mode == "all" || mode == Mode::name()) return true;
   }
+  return false;
+}
 
-  ContainerT& _c;
-};
-
-int main()
+int main(int argc, char** argv)
 {
-#ifdef STATIC_POLY
-  typedef create_rtc< types, RuntimeContainer<> >::type Container_t;
-  Container_t container;
+  int nrolls = 1000000000;
+#ifdef NROLLS
+  nrolls = NROLLS;
+#endif
+  if (argc > 1) {
+    nrolls = std::atoi(argv[1]);
+  }
+
+  std::vector<std::string> modes(argv + std::min(argc, 2), argv + argc);
+  if (modes.empty()) {
+#if defined(BULK_OPERATION)
+    modes.push_back(BulkMode::name());
+#elif defined(STATIC_POLY)
+    modes.push_back(StaticMode::name());
 #else
-  std::vector<Interface*> container;
-  boost::mpl::for_each<types>(add_object<std::vector<Interface*>>(container));
+    modes.push_back("all");
 #endif
+  }
 
-  int nrolls = 1000000000;
-#ifdef NROLLS
-  nrolls = NROLLS
+  std::vector<std::string> known = {"all", VirtualMode::name(), StaticMode::name(), BulkMode::name()};
+#if __cplusplus >= 201703L
+  known.push_back(VariantMode::name());
+  known.push_back(SwitchMode::name());
 #endif
+  for (auto& mode : modes) {
+    if (std::find(known.begin(), known.end(), mode) != known.end()) continue;
+    std::cerr << "unknown mode '" << mode << "'" << std::endl;
+    std::cerr << "Usage: " << argv[0] << " [nrolls [mode...]]" << std::endl << "       modes:";
+    for (auto& name : known) std::cerr << " " << name;
+    std::cerr << std::endl;
+    return 1;
+  }
 
-  test_loop(container, nrolls);
+  Results reference;
+  int result = 0;
+  if (select_mode<VirtualMode>(modes)) result |= test_loop<VirtualMode>(nrolls, reference);
+  if (select_mode<StaticMode>(modes)) result |= test_loop<StaticMode>(nrolls, reference);
+  if (select_mode<BulkMode>(modes)) result |= test_loop<BulkMode>(nrolls, reference);
+#if __cplusplus >= 201703L
+  if (select_mode<VariantMode>(modes)) result |= test_loop<VariantMode>(nrolls, reference);
+  if (select_mode<SwitchMode>(modes)) result |= test_loop<SwitchMode>(nrolls, reference);
+#endif
 
-  return 0;
+  return result;
 }
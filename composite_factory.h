@@ -22,6 +22,12 @@
 // The composite factory is a compile time factory for creating combinations
 // of the mixin objects depending on a property flag. An MPL map of flags to
 // mixin templates has to be provided to the CompositeCreator functor
+//
+// The object for the selected wrappers is made by a creator policy, the
+// default SharedMixinCreator folds the wrappers onto the base and returns a
+// shared pointer. Other creators can interpret the selected sequence
+// differently, e.g. as member types of a runtime container, see
+// rc_shape_factory.h
 
 #include <memory>
 #include <boost/mpl/deref.hpp>
@@ -32,6 +38,35 @@
 #include <boost/mpl/fold.hpp>
 #include <boost/mpl/apply.hpp>
 
+/******************************************************************************
+ * @brief default creator policy: fold the wrappers onto the base
+ *
+ * A creator policy defines the return_type of the factory and the function
+ * template create for the sequence of selected wrappers. The runtime
+ * property is passed on to the creator.
+ */
+template < typename _Interface, typename _Base >
+struct SharedMixinCreator
+{
+  typedef std::shared_ptr< _Interface > return_type;
+
+  template < typename _Wrappers, typename _Property >
+  static return_type create( _Property /*property*/ )
+  {
+    using boost::mpl::placeholders::_1;
+    using boost::mpl::placeholders::_2;
+
+    typedef typename
+      boost::mpl::fold<
+        _Wrappers,
+        _Base,
+        boost::mpl::apply1< _2, _1 >
+      >::type mixin;
+
+    return std::make_shared< mixin >();
+  }
+};
+
 /******************************************************************************
  * @brief apply functor for recursive accumulation of creation wrappers
  * depending on runtime property.
@@ -52,10 +87,11 @@ template < typename _Interface,
            typename _Iterator,
            typename _End,
            typename _Property,
-           typename _WrappersToApply >
+           typename _WrappersToApply,
+           typename _Creator = SharedMixinCreator< _Interface, _Base > >
 struct WrapperAccumulation
 {
-  static std::shared_ptr< _Interface > apply( _Property property )
+  static typename _Creator::return_type apply( _Property property )
   {
     typedef typename boost::mpl::deref< _Iterator >::type        flag_to_wrapper;
     typedef typename boost::mpl::first< flag_to_wrapper >::type  flag;
@@ -72,7 +108,8 @@ struct WrapperAccumulation
         typename boost::mpl::push_back<
           _WrappersToApply,
           wrapper
-          >::type
+          >::type,
+        _Creator
         >::apply( property );
     } else {
       // don't add current wrapper
@@ -82,7 +119,8 @@ struct WrapperAccumulation
         typename boost::mpl::next< _Iterator >::type,
         _End,
         _Property,
-        _WrappersToApply
+        _WrappersToApply,
+        _Creator
       >::apply( property );
     }
   }
@@ -94,30 +132,22 @@ struct WrapperAccumulation
  * The termination in the recursive loop is realized through partial template
  * specialization and reached when _Iterator is the same as _End
  *
- * Now, the complete mixin type is build from the selected wrappers by folding.
- * Finally, a shared pointer of this type is created.
+ * Now, the object is created from the selected wrappers by the creator, the
+ * default creator builds the complete mixin type by folding and returns a
+ * shared pointer of this type.
  */
 template < typename _Interface,
            typename _Base, 
            typename _End,
            typename _Property,
-           typename _WrappersToApply >
+           typename _WrappersToApply,
+           typename _Creator >
 struct WrapperAccumulation< _Interface, _Base, 
-                            _End, _End, _Property, _WrappersToApply >
+                            _End, _End, _Property, _WrappersToApply, _Creator >
 {
-  static std::shared_ptr< _Interface > apply( _Property property )
+  static typename _Creator::return_type apply( _Property property )
   {
-    using boost::mpl::placeholders::_1;
-    using boost::mpl::placeholders::_2;
-
-    typedef typename
-      boost::mpl::fold<
-        _WrappersToApply,
-        _Base,
-        boost::mpl::apply1< _2, _1 >
-      >::type mixin;
-
-    return std::make_shared< mixin >();
+    return _Creator::template create< _WrappersToApply >( property );
   }
 };
 
@@ -132,14 +162,14 @@ struct WrapperAccumulation< _Interface, _Base,
  * - _Base       Base of mixin type
  * - _Property   Type of runtime property field to select wrappers
  * - WrapperMap  MPL map of property flags to wrappers
- *
- * TODO:
- * - return type and pointer creation can be generalized
+ * - _Creator    creates the object from the selected wrappers, see
+ *               SharedMixinCreator
  */
-template < typename _Interface, typename _Base, typename _Property, typename WrapperMap >
+template < typename _Interface, typename _Base, typename _Property, typename WrapperMap,
+           typename _Creator = SharedMixinCreator< _Interface, _Base > >
 struct CompositeCreator
 {
-  static std::shared_ptr< _Interface > apply( _Property property )
+  static typename _Creator::return_type apply( _Property property )
   {
     return WrapperAccumulation<
       _Interface,
@@ -147,7 +177,8 @@ struct CompositeCreator
       typename boost::mpl::begin< WrapperMap >::type,
       typename boost::mpl::end< WrapperMap >::type,
       _Property,
-      boost::mpl::vector< >
+      boost::mpl::vector< >,
+      _Creator
     >::apply( property );
   }
 };
@@ -0,0 +1,379 @@
+//-*- Mode: C++ -*-
+
+#ifndef HETEROGENEOUS_VECTOR_H
+#define HETEROGENEOUS_VECTOR_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   heterogeneous_vector.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  A type-tagged sequence of objects of different types
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// A heterogeneous sequence of objects of the types in a compile time
+// sequence. The objects are stored by value in per-type contiguous pools,
+// the pools are the levels of a runtime container with one std::vector per
+// type. The sequence itself is described by a compact index of type tags
+// and the slot of the object in its pool. This replaces a vector of
+// pointers to objects with a common virtual interface.
+
+#include "runtime_container.h"
+#include <boost/mpl/find.hpp>
+#include <boost/mpl/transform.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gNeric
+{
+/**
+ * @class TypePartition
+ * @brief Partition of a sequence of type tags by type
+ *
+ * Counting sort of the tags, the positions of the elements of one type are
+ * stored contiguously in ascending order starting at offset(tag). This is
+ * the order of the elements in the pools of the HeterogeneousVector, the
+ * partition maps the pool slots back to the original positions.
+ */
+template <typename TagType, typename IndexType, int NTypes>
+class TypePartition
+{
+ public:
+  typedef TagType tag_type;
+  typedef IndexType index_type;
+
+  TypePartition() : mOffsets(NTypes + 1, 0), mPositions() {}
+
+  /// build the partition from a sequence of n tags
+  void build(const tag_type* tags, std::size_t n)
+  {
+    std::fill(mOffsets.begin(), mOffsets.end(), 0);
+    for (std::size_t i = 0; i < n; i++) {
+      ++mOffsets[tags[i] + 1];
+    }
+    for (int type = 0; type < NTypes; type++) {
+      mOffsets[type + 1] += mOffsets[type];
+    }
+    std::vector<index_type> next(mOffsets.begin(), mOffsets.end() - 1);
+    mPositions.resize(n);
+    for (std::size_t i = 0; i < n; i++) {
+      mPositions[next[tags[i]]++] = static_cast<index_type>(i);
+    }
+  }
+
+  /// offset of the group of a type
+  index_type offset(int type) const { return mOffsets[type]; }
+  /// number of elements of a type
+  index_type count(int type) const { return mOffsets[type + 1] - mOffsets[type]; }
+  /// the original positions in the order of the partition
+  const std::vector<index_type>& positions() const { return mPositions; }
+  /// total number of elements
+  std::size_t size() const { return mPositions.size(); }
+
+ private:
+  std::vector<index_type> mOffsets;
+  std::vector<index_type> mPositions;
+};
+
+/**
+ * @class HeterogeneousVector
+ * @brief Sequence of objects of the types of an mpl sequence
+ *
+ * Objects are added with push_back or emplace_back and are stored in the
+ * pool of their type. Functors are applied to the elements either
+ * - in insertion order: the type tag of every element is dispatched to the
+ *   pool by the runtime container
+ * - grouped by type: all elements of a pool are processed in one loop
+ *   without any dispatch
+ *
+ * The transform function processes all elements grouped by type and stores
+ * the results either in grouped order or, using the partition of the type
+ * tags, in the original insertion order.
+ *
+ * The element functor follows the functor convention of the runtime
+ * container, it defines 'return_type' and a templated operator() which is
+ * called with a reference to the element.
+ *
+ * Template parameters:
+ * - Types     mpl sequence of the element types
+ * - TagType   integral type of the type tag
+ * - IndexType integral type of the slot index in the pool
+ */
+template <typename Types, typename TagType = unsigned char, typename IndexType = unsigned int>
+class HeterogeneousVector
+{
+ public:
+  typedef Types types;
+  typedef TagType tag_type;
+  typedef IndexType index_type;
+  /// the sequence of pool types, one std::vector per element type
+  typedef typename boost::mpl::transform<Types, std::vector<_1>>::type pool_types;
+  /// the runtime container holding the pools
+  typedef typename create_rtc<pool_types, RuntimeContainer<>>::type pool_container;
+  /// partition of the elements by type
+  typedef TypePartition<tag_type, index_type, boost::mpl::size<Types>::value> partition_type;
+
+  static_assert(boost::mpl::size<Types>::value <= std::numeric_limits<tag_type>::max() + 1,
+                "tag type too small for the number of types");
+
+  /// the type tag of an element type, i.e. its position in the type sequence
+  template <typename T>
+  struct type_tag {
+    typedef typename boost::mpl::find<Types, T>::type iterator;
+    static_assert(!boost::is_same<iterator, typename boost::mpl::end<Types>::type>::value,
+                  "type is not in the type sequence of the heterogeneous vector");
+    static const tag_type value = iterator::pos::value;
+  };
+
+  /// the pool type of an element type
+  template <typename T>
+  struct pool_stage {
+    typedef typename boost::mpl::at_c<typename pool_container::types, type_tag<T>::value>::type type;
+  };
+
+  HeterogeneousVector() : mPools(), mTags(), mSlots() {}
+
+  /// number of elements
+  std::size_t size() const { return mTags.size(); }
+  /// check if the vector is empty
+  bool empty() const { return mTags.empty(); }
+  /// reserve space in the index for n elements
+  void reserve(std::size_t n)
+  {
+    mTags.reserve(n);
+    mSlots.reserve(n);
+  }
+  /// remove all elements
+  void clear()
+  {
+    mPools.for_each(clear_pool());
+    mTags.clear();
+    mSlots.clear();
+  }
+
+  /// add an element
+  template <typename T>
+  void push_back(const T& v)
+  {
+    std::vector<T>& target = pool<T>();
+    add_index(type_tag<T>::value, target.size());
+    target.push_back(v);
+  }
+
+  /// construct an element of type T in place
+  template <typename T, typename... Args>
+  T& emplace_back(Args&&... args)
+  {
+    std::vector<T>& target = pool<T>();
+    add_index(type_tag<T>::value, target.size());
+    target.emplace_back(std::forward<Args>(args)...);
+    return target.back();
+  }
+
+  /// the type tag of element at position i
+  tag_type tag(std::size_t i) const { return mTags[i]; }
+  /// check if element at position i is of type T
+  template <typename T>
+  bool holds(std::size_t i) const
+  {
+    return mTags[i] == type_tag<T>::value;
+  }
+  /// pointer to element at position i if it is of type T, nullptr otherwise
+  template <typename T>
+  T* get_if(std::size_t i)
+  {
+    return holds<T>(i) ? &pool<T>()[mSlots[i]] : nullptr;
+  }
+
+  /// the pool of all elements of type T
+  template <typename T>
+  std::vector<T>& pool()
+  {
+    return *static_cast<typename pool_stage<T>::type&>(mPools);
+  }
+  template <typename T>
+  const std::vector<T>& pool() const
+  {
+    return *static_cast<const typename pool_stage<T>::type&>(mPools);
+  }
+
+  /// the runtime container of all pools
+  pool_container& pools() { return mPools; }
+
+  /// apply functor to element at position i
+  template <typename F>
+  typename F::return_type apply(std::size_t i, F f)
+  {
+    return mPools.apply(mTags[i], element_apply<F>(f, mSlots[i]));
+  }
+
+  /// apply functor to all elements in insertion order
+  template <typename F>
+  void for_each(F f)
+  {
+    const std::size_t n = mTags.size();
+    for (std::size_t i = 0; i < n; i++) {
+      mPools.apply(mTags[i], element_apply<F>(f, mSlots[i]));
+    }
+  }
+
+  /// apply functor to all elements grouped by type, there is no dispatch
+  /// inside the loop over the elements of one type
+  template <typename F>
+  void for_each_grouped(F f)
+  {
+    mPools.for_each(pool_apply<F>(f));
+  }
+
+  /// the partition of the elements by type, needs to be rebuilt after
+  /// adding elements
+  partition_type partition() const
+  {
+    partition_type p;
+    p.build(mTags.data(), mTags.size());
+    return p;
+  }
+
+  /// apply functor to all elements grouped by type and store the results
+  /// in grouped order, i.e. in the order of the partition
+  template <typename F>
+  void transform(F f, std::vector<typename F::return_type>& result)
+  {
+    static_assert(!std::is_same<typename F::return_type, bool>::value,
+                  "std::vector<bool> can not hold the results, use e.g. char as return type");
+    result.resize(mTags.size());
+    mPools.for_each(pool_transform<F, false>(f, result.data(), nullptr));
+  }
+
+  /// apply functor to all elements grouped by type and store the results
+  /// in the original insertion order, the partition must be built from the
+  /// current elements, std::invalid_argument is thrown if the size differs
+  template <typename F>
+  void transform(F f, std::vector<typename F::return_type>& result, const partition_type& p)
+  {
+    static_assert(!std::is_same<typename F::return_type, bool>::value,
+                  "std::vector<bool> can not hold the results, use e.g. char as return type");
+    if (p.size() != mTags.size()) {
+      throw std::invalid_argument("HeterogeneousVector: partition does not match the elements");
+    }
+    result.resize(mTags.size());
+    mPools.for_each(pool_transform<F, true>(f, result.data(), p.positions().data()));
+  }
+
+ private:
+  void add_index(tag_type tag, std::size_t slot)
+  {
+    mTags.push_back(tag);
+    mSlots.push_back(static_cast<index_type>(slot));
+  }
+
+  /// forward functor from the pool to the element at a slot
+  template <typename F>
+  class element_apply
+  {
+   public:
+    typedef typename F::return_type return_type;
+    element_apply(F& f, index_type slot) : mFunctor(f), mSlot(slot) {}
+    template <typename StageT>
+    return_type operator()(StageT& stage)
+    {
+      return mFunctor((*stage)[mSlot]);
+    }
+
+   private:
+    element_apply(); // forbidden
+    F& mFunctor;
+    index_type mSlot;
+  };
+
+  /// apply functor to all elements of a pool
+  template <typename F>
+  class pool_apply
+  {
+   public:
+    typedef void return_type;
+    pool_apply(F& f) : mFunctor(f) {}
+    template <typename StageT>
+    return_type operator()(StageT& stage)
+    {
+      for (auto& element : *stage) {
+        mFunctor(element);
+      }
+    }
+
+   private:
+    pool_apply(); // forbidden
+    F& mFunctor;
+  };
+
+  /// apply functor to all elements of a pool and write the results either
+  /// contiguously or to the original positions
+  template <typename F, bool restoreOrder>
+  class pool_transform
+  {
+   public:
+    typedef void return_type;
+    typedef typename F::return_type result_type;
+    pool_transform(F& f, result_type* result, const index_type* positions)
+      : mFunctor(f), mResult(result), mPositions(positions)
+    {
+    }
+    template <typename StageT>
+    return_type operator()(StageT& stage)
+    {
+      auto& pool = *stage;
+      const std::size_t n = pool.size();
+      if (restoreOrder) { // this is a compile time switch
+        for (std::size_t i = 0; i < n; i++) {
+          mResult[mPositions[i]] = mFunctor(pool[i]);
+        }
+      } else {
+        for (std::size_t i = 0; i < n; i++) {
+          mResult[i] = mFunctor(pool[i]);
+        }
+      }
+      // the pools are visited in the order of the types, which is the order
+      // of the partition
+      mResult += restoreOrder ? 0 : n;
+      mPositions += restoreOrder ? n : 0;
+    }
+
+   private:
+    pool_transform(); // forbidden
+    F& mFunctor;
+    result_type* mResult;
+    const index_type* mPositions;
+  };
+
+  struct clear_pool {
+    typedef void return_type;
+    template <typename StageT>
+    return_type operator()(StageT& stage)
+    {
+      (*stage).clear();
+    }
+  };
+
+  pool_container mPools;
+  std::vector<tag_type> mTags;
+  std::vector<index_type> mSlots;
+};
+
+}; // namespace gNeric
+
+#endif
@@ -0,0 +1,23 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   instantiation_demo.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  The explicit instantiations of instantiation_demo.h
+
+#include "instantiation_demo.h"
+
+RC_INSTANTIATE_FUNCTOR(demo_container, demo_fill)
+RC_INSTANTIATE_FUNCTOR(demo_container, demo_scale)
+RC_INSTANTIATE_FUNCTOR(demo_container, demo_value)
+RC_INSTANTIATE_FUNCTOR(demo_container, demo_format)
@@ -0,0 +1,122 @@
+//-*- Mode: C++ -*-
+
+#ifndef INSTANTIATION_DEMO_H
+#define INSTANTIATION_DEMO_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   instantiation_demo.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Container and functors shared by the units of instantiation_demo
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// The container has 32 levels of 8 types, the functors are applied with
+// apply and for_each in the units of the program. The functions are declared
+// as explicitly instantiated, the instantiations are in
+// instantiation_demo.cxx. Compiled with RC_NO_EXTERN_TEMPLATES every unit
+// instantiates the functions itself, see bench_instantiation.sh.
+//
+// The source instantiation_demo_unit.cxx can be compiled into any number of
+// units of one program, every unit registers its function with a
+// demo_unit_registration object, instantiation_demo_main.cxx calls all.
+
+#include "runtime_container.h"
+#include "rc_explicit_instantiation.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/fold.hpp>
+#include <boost/mpl/int.hpp>
+#include <boost/mpl/modulus.hpp>
+#include <boost/mpl/push_back.hpp>
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/vector.hpp>
+
+typedef boost::mpl::vector<double, float, int, long, short, unsigned, long long, unsigned char> demo_base_types;
+typedef boost::mpl::fold<
+  boost::mpl::range_c<int, 0, 32>, boost::mpl::vector<>,
+  boost::mpl::push_back<boost::mpl::_1, boost::mpl::at<demo_base_types, boost::mpl::modulus<boost::mpl::_2,
+                                                                                           boost::mpl::int_<8>>>>>::type
+  demo_types;
+typedef gNeric::create_rtc<demo_types, gNeric::RuntimeContainer<>>::type demo_container;
+
+/// fill a level from a seed
+struct demo_fill {
+  typedef void return_type;
+  demo_fill(std::size_t seed) : mSeed(seed) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    stage = (typename T::wrapped_type)((mSeed * 31 + T::level::value * 7) % 101);
+  }
+  std::size_t mSeed;
+};
+
+/// scale a level
+struct demo_scale {
+  typedef void return_type;
+  demo_scale(double factor) : mFactor(factor) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    stage = (typename T::wrapped_type)(*stage * mFactor);
+  }
+  double mFactor;
+};
+
+/// value of a level
+struct demo_value {
+  typedef double return_type;
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    return *stage;
+  }
+};
+
+/// append a level to a string
+struct demo_format {
+  typedef void return_type;
+  demo_format(std::string& line) : mLine(line) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), " %g", (double)*stage);
+    mLine += buffer;
+  }
+  std::string& mLine;
+};
+
+RC_EXTERN_FUNCTOR(demo_container, demo_fill)
+RC_EXTERN_FUNCTOR(demo_container, demo_scale)
+RC_EXTERN_FUNCTOR(demo_container, demo_value)
+RC_EXTERN_FUNCTOR(demo_container, demo_format)
+
+/// function of a unit, returns a checksum of the processed containers
+typedef double (*demo_unit_function)(std::size_t ncontainers);
+
+/// the registered functions of all units
+inline std::vector<demo_unit_function>& demo_units()
+{
+  static std::vector<demo_unit_function> units;
+  return units;
+}
+
+/// registers the function of a unit at static initialization
+struct demo_unit_registration {
+  demo_unit_registration(demo_unit_function f) { demo_units().push_back(f); }
+};
+
+#endif
@@ -0,0 +1,46 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   instantiation_demo_main.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Multi-unit program with explicitly instantiated container functions
+///
+/// The container and functors of instantiation_demo.h are used in the units
+/// compiled from instantiation_demo_unit.cxx, the program calls the function
+/// of every unit and prints the checksums. The build is measured by
+/// bench_instantiation.sh.
+///
+/// Compilation:
+/// g++ --std=c++11 -O2 -I$BOOST_ROOT/include -c instantiation_demo.cxx instantiation_demo_*.cxx
+/// g++ -o instantiation_demo instantiation_demo.o instantiation_demo_*.o
+/// without explicit instantiation, instantiation_demo.cxx is not needed:
+/// g++ --std=c++11 -O2 -DRC_NO_EXTERN_TEMPLATES -I$BOOST_ROOT/include -c instantiation_demo_*.cxx
+/// g++ -o instantiation_demo_implicit instantiation_demo_*.o
+///
+/// Usage: instantiation_demo [ncontainers]
+///        ncontainers: containers per unit, default 1000
+
+#include "instantiation_demo.h"
+#include <iostream>
+#include <cstdlib>
+
+int main(int argc, char** argv)
+{
+  std::size_t ncontainers = argc > 1 ? std::atoll(argv[1]) : 1000;
+
+  std::cout << "levels " << demo_container().size() << ", units " << demo_units().size() << std::endl;
+  for (std::size_t i = 0; i < demo_units().size(); i++) {
+    std::cout << "unit " << i << ": checksum " << demo_units()[i](ncontainers) << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,47 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   instantiation_demo_unit.cxx
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Unit of instantiation_demo: fill, scale, sum and format containers
+///
+/// All symbols are local, the source can be compiled into several units of
+/// the same program.
+
+#include "instantiation_demo.h"
+
+namespace
+{
+double process(std::size_t ncontainers)
+{
+  std::vector<demo_container> containers(ncontainers);
+  for (std::size_t i = 0; i < containers.size(); i++) {
+    containers[i].for_each(demo_fill(i));
+    containers[i].apply(i % containers[i].size(), demo_scale(2.));
+    containers[i].for_each(demo_scale(0.5));
+  }
+
+  double sum = 0.;
+  std::size_t length = 0;
+  for (auto& container : containers) {
+    for (int level = 0; level < (int)container.size(); level++) sum += container.apply(level, demo_value());
+    std::string line;
+    container.for_each(demo_format(line));
+    container.apply(0, demo_format(line));
+    length += line.size();
+  }
+  return sum + length;
+}
+
+demo_unit_registration registration(&process);
+}
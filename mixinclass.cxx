@@ -21,13 +21,52 @@
 // g++ -o mixinclass -std=c++11 mixinclass.cxx
 //
 // run:
-// ./mixinclass
+// ./mixinclass [ncalls]
 
 #include "mixinclass.h"
+#include <chrono>
+#include <cstdlib>
 
 typedef BaseFunctionality<int> IntFunctionality;
+typedef BaseFunctionality<int, NoInterface> StaticIntFunctionality;
 
-int main()
+typedef std::chrono::steady_clock steady_clock;
+typedef std::chrono::nanoseconds TimeScale;
+
+/// call print through the virtual interface, the actual assembly is not
+/// known in this function
+void print_virtual(Interface& i, int ncalls)
+{
+  for (int call = 0; call < ncalls; call++) {
+    i.print();
+  }
+}
+
+/// call print through the static interface, can be inlined completely
+template<typename Derived>
+void print_static(StaticInterface<Derived>& i, int ncalls)
+{
+  for (int call = 0; call < ncalls; call++) {
+    i.print();
+  }
+}
+
+template<typename F>
+long long measure(F f)
+{
+  // suppress the output, the stream operators return immediately for
+  // a stream without buffer and the calls are dominating
+  std::streambuf* buffer = std::cout.rdbuf(nullptr);
+  steady_clock::time_point refTime = steady_clock::now();
+  f();
+  auto duration = std::chrono::duration_cast<TimeScale>(steady_clock::now() - refTime);
+  std::cout.rdbuf(buffer);
+  std::cout.clear();
+  std::cout << std::dec;
+  return duration.count();
+}
+
+int main(int argc, char** argv)
 {
   hex<IntFunctionality > plainhex;
   oct< hex<IntFunctionality > > octhex;
@@ -42,4 +81,21 @@ int main()
   octdechex.print();
   std::cout << "==============================" << std::endl;
   octdecoct.print();
+
+  StaticAssembly< oct< dec< hex<StaticIntFunctionality > > > > staticoctdechex;
+  std::cout << "==============================" << std::endl;
+  std::cout << "static assembly, same output without vptr:" << std::endl;
+  staticoctdechex.print();
+
+  std::cout << "==============================" << std::dec << std::endl;
+  std::cout << "object size virtual interface: " << sizeof(octdechex) << std::endl;
+  std::cout << "object size static interface:  " << sizeof(staticoctdechex) << std::endl;
+
+  int ncalls = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  long long durationVirtual = measure([&]() { print_virtual(octdechex, ncalls); });
+  long long durationStatic = measure([&]() { print_static(staticoctdechex, ncalls); });
+  std::cout << ncalls << " call(s) virtual interface: " << durationVirtual << " ns, "
+            << (double)durationVirtual / ncalls << " ns/call" << std::endl;
+  std::cout << ncalls << " call(s) static interface:  " << durationStatic << " ns, "
+            << (double)durationStatic / ncalls << " ns/call" << std::endl;
 }
@@ -33,15 +33,49 @@
 /**
  * @class Interface
  * A common interface
+ *
+ * The virtual interface is needed if the concrete mixin assembly is only known
+ * at runtime, e.g. objects created by the CompositeCreator. Objects of this
+ * type can be deleted through the interface.
  */
 class Interface {
  public:
   Interface() {}
-  ~Interface() {}
+  virtual ~Interface() {}
 
   virtual void print() = 0;
 };
 
+/**
+ * @class NoInterface
+ * Empty interface for the static variant of the mixin class, mixin objects
+ * with this base do not carry a vptr.
+ */
+class NoInterface {
+};
+
+/**
+ * @class StaticInterface
+ * @brief CRTP interface for mixin assemblies known at compile time
+ *
+ * The interface forwards to the implementation of the derived class by a
+ * static cast, the calls can be fully inlined by the compiler. Functions
+ * accepting a StaticInterface<Derived> reference are written once for all
+ * assemblies, similar to functions accepting the virtual Interface.
+ */
+template<typename Derived>
+class StaticInterface {
+ public:
+  void print() { derived().print(); }
+
+ protected:
+  StaticInterface() {}
+  ~StaticInterface() {}
+
+ private:
+  Derived& derived() { return static_cast<Derived&>(*this); }
+};
+
 /**
  * @class BaseFunctionality
  * @brief Basic functionality of the mixin class
@@ -51,9 +85,12 @@ class Interface {
  * the "orthogonal" mixin functionality. It is also possible to define individual
  * functions per mixin template, that implies also an extension of the interface
  * class.
+ *
+ * The interface is a template parameter, the default is the virtual interface.
+ * Use NoInterface for the static variant, see StaticAssembly.
  */
-template<typename T>
-struct BaseFunctionality : public Interface
+template<typename T, typename InterfaceT = Interface>
+struct BaseFunctionality : public InterfaceT
 {
  BaseFunctionality() : value(0xdead) {}
   typedef T value_type;
@@ -106,4 +143,20 @@ struct oct : public BASE
     BASE::print();
   }
 };
+
+/**
+ * @class StaticAssembly
+ * @brief Completes a mixin assembly with the static interface
+ *
+ * The mixin stages are built on top of BaseFunctionality<T, NoInterface>,
+ * e.g. StaticAssembly<oct<hex<BaseFunctionality<int, NoInterface> > > >.
+ * The most derived type is only known after the mixin has been assembled,
+ * that's why the CRTP base is added by this final stage.
+ */
+template <typename MIXIN>
+struct StaticAssembly : public MIXIN, public StaticInterface<StaticAssembly<MIXIN> >
+{
+  typedef typename MIXIN::value_type value_type;
+  using MIXIN::print;
+};
 #endif
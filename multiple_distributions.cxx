@@ -59,7 +59,7 @@ private:
   template<typename U, typename V>
   struct ParamTypeTraits {
     template<typename DistributionType>
-    static return_type apply(DistributionType& distribution, ParamType& param) {
+    static return_type apply(DistributionType& /*distribution*/, ParamType& /*param*/) {
       throw std::runtime_error("parameter type mismatch");
     }
   };
@@ -0,0 +1,443 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_ASYNC_H
+#define RC_ASYNC_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_async.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Asynchronous apply of level functors with C++20 coroutines
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// apply_async runs a functor on one level of a container on an executor and
+// returns an awaitable task, for_each_async starts one task per level and
+// returns a task which completes when all levels are done. A slow level, e.g.
+// a functor loading calibration data from a file, does not stall the others.
+//
+// Usage:
+//   rc_thread_pool pool(4);
+//   rc_sync_wait(for_each_async(pool, container, load_calibration()));
+//   double value = rc_sync_wait(apply_async(pool, container, 2, get_value<double>()));
+//
+// An executor is any type with a schedule() function returning an awaitable
+// which resumes the coroutine on the executor, see rc_thread_pool and
+// rc_inline_executor. The functor of a level can itself be a coroutine: if
+// F::return_type is rc_task<U>, the task is awaited and the result is U. Such
+// a functor can move to another executor, e.g. with co_await io.schedule(),
+// to wait for I/O without blocking a thread of the compute executor.
+//
+// The levels are accessed concurrently, the tracking policy of the container
+// is not thread-safe, use the default no_tracking. The container has to
+// outlive the tasks. Requires C++20.
+
+#include "runtime_container.h"
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gNeric
+{
+template <typename T = void>
+class rc_task;
+
+/**
+ * @brief Common part of the promise of rc_task
+ * The task starts suspended, at the end it resumes the awaiting coroutine.
+ */
+class rc_task_promise_base
+{
+ public:
+  struct final_awaiter {
+    bool await_ready() noexcept { return false; }
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+    {
+      std::coroutine_handle<> continuation = handle.promise().mContinuation;
+      return continuation ? continuation : std::noop_coroutine();
+    }
+    void await_resume() noexcept {}
+  };
+
+  std::suspend_always initial_suspend() noexcept { return {}; }
+  final_awaiter final_suspend() noexcept { return {}; }
+  void unhandled_exception() { mException = std::current_exception(); }
+
+  std::coroutine_handle<> mContinuation;
+  std::exception_ptr mException;
+};
+
+template <typename T>
+class rc_task_promise : public rc_task_promise_base
+{
+ public:
+  rc_task<T> get_return_object();
+  template <typename U>
+  void return_value(U&& value)
+  {
+    mValue.emplace(std::forward<U>(value));
+  }
+  T result()
+  {
+    if (mException) std::rethrow_exception(mException);
+    return std::move(*mValue);
+  }
+
+ private:
+  std::optional<T> mValue;
+};
+
+template <>
+class rc_task_promise<void> : public rc_task_promise_base
+{
+ public:
+  rc_task<void> get_return_object();
+  void return_void() {}
+  void result()
+  {
+    if (mException) std::rethrow_exception(mException);
+  }
+};
+
+/**
+ * @class rc_task
+ * @brief Lazily started coroutine with a result of type T
+ *
+ * The task is started when it is awaited, the awaiting coroutine is resumed
+ * when the task has finished. An exception of the task is rethrown by
+ * co_await.
+ */
+template <typename T>
+class rc_task
+{
+ public:
+  typedef rc_task_promise<T> promise_type;
+  typedef std::coroutine_handle<promise_type> handle_type;
+  typedef T value_type;
+
+  explicit rc_task(handle_type handle) : mHandle(handle) {}
+  rc_task(rc_task&& other) noexcept : mHandle(std::exchange(other.mHandle, nullptr)) {}
+  rc_task& operator=(rc_task&& other) noexcept
+  {
+    if (this != &other) {
+      if (mHandle) mHandle.destroy();
+      mHandle = std::exchange(other.mHandle, nullptr);
+    }
+    return *this;
+  }
+  rc_task(const rc_task&) = delete;
+  rc_task& operator=(const rc_task&) = delete;
+  ~rc_task()
+  {
+    if (mHandle) mHandle.destroy();
+  }
+
+  /// awaiter which starts the task and waits without taking the result
+  struct ready_awaiter {
+    bool await_ready() const noexcept { return mHandle.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+      mHandle.promise().mContinuation = awaiting;
+      return mHandle;
+    }
+    void await_resume() noexcept {}
+    handle_type mHandle;
+  };
+  ready_awaiter when_ready() const { return {mHandle}; }
+  /// result of the finished task
+  T result() { return mHandle.promise().result(); }
+
+  bool await_ready() const noexcept { return mHandle.done(); }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+  {
+    return when_ready().await_suspend(awaiting);
+  }
+  T await_resume() { return result(); }
+
+ private:
+  handle_type mHandle;
+};
+
+template <typename T>
+rc_task<T> rc_task_promise<T>::get_return_object()
+{
+  return rc_task<T>(std::coroutine_handle<rc_task_promise<T>>::from_promise(*this));
+}
+inline rc_task<void> rc_task_promise<void>::get_return_object()
+{
+  return rc_task<void>(std::coroutine_handle<rc_task_promise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief Eagerly started coroutine without result, destroys itself at the end
+ */
+struct rc_detached {
+  struct promise_type {
+    rc_detached get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+/**
+ * @brief Latch of rc_when_all, the awaiting coroutine is resumed by the last
+ * of the tasks
+ */
+class rc_when_all_latch
+{
+ public:
+  explicit rc_when_all_latch(std::size_t count) : mCount(count + 1) {}
+
+  /// called by each task when finished
+  void notify()
+  {
+    if (arrive()) mContinuation.resume();
+  }
+
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(std::coroutine_handle<> awaiting) noexcept
+  {
+    mContinuation = awaiting;
+    return !arrive();
+  }
+  void await_resume() noexcept {}
+
+ private:
+  bool arrive() { return mCount.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+  std::atomic<std::size_t> mCount;
+  std::coroutine_handle<> mContinuation;
+};
+
+template <typename T>
+rc_detached rc_when_all_start(rc_task<T>& task, rc_when_all_latch& latch)
+{
+  co_await task.when_ready();
+  latch.notify();
+}
+
+/// start all tasks and wait until they have finished
+template <typename T>
+rc_task<void> rc_when_all_ready(std::vector<rc_task<T>>& tasks)
+{
+  rc_when_all_latch latch(tasks.size());
+  for (auto& task : tasks) rc_when_all_start(task, latch);
+  co_await latch;
+}
+
+/// run the tasks concurrently, the result is the vector of the task results
+template <typename T>
+rc_task<std::vector<T>> rc_when_all(std::vector<rc_task<T>> tasks)
+{
+  co_await rc_when_all_ready(tasks);
+  std::vector<T> results;
+  results.reserve(tasks.size());
+  for (auto& task : tasks) results.push_back(task.result());
+  co_return results;
+}
+
+inline rc_task<void> rc_when_all(std::vector<rc_task<void>> tasks)
+{
+  co_await rc_when_all_ready(tasks);
+  for (auto& task : tasks) task.result();
+}
+
+/**
+ * @brief Event signaled by the task of rc_sync_wait
+ */
+class rc_sync_event
+{
+ public:
+  rc_sync_event() : mSet(false) {}
+  void set()
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSet = true;
+    mCondition.notify_one();
+  }
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this]() { return mSet; });
+  }
+
+ private:
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  bool mSet;
+};
+
+template <typename T>
+rc_detached rc_sync_start(rc_task<T>& task, rc_sync_event& event)
+{
+  co_await task.when_ready();
+  event.set();
+}
+
+/// run the task and block the calling thread until it has finished
+template <typename T>
+T rc_sync_wait(rc_task<T> task)
+{
+  rc_sync_event event;
+  rc_sync_start(task, event);
+  event.wait();
+  return task.result();
+}
+
+/**
+ * @class rc_thread_pool
+ * @brief Executor with a fixed number of threads
+ *
+ * co_await pool.schedule() resumes the coroutine on one of the threads. The
+ * queued coroutines are run before the threads are joined by the destructor.
+ */
+class rc_thread_pool
+{
+ public:
+  explicit rc_thread_pool(std::size_t nThreads) : mStop(false)
+  {
+    if (nThreads == 0) nThreads = 1;
+    for (std::size_t i = 0; i < nThreads; i++) {
+      mThreads.emplace_back([this]() { run(); });
+    }
+  }
+  ~rc_thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mCondition.notify_all();
+    for (auto& thread : mThreads) thread.join();
+  }
+
+  struct schedule_awaiter {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { mPool.post(handle); }
+    void await_resume() noexcept {}
+    rc_thread_pool& mPool;
+  };
+  schedule_awaiter schedule() { return {*this}; }
+
+  /// queue a coroutine to be resumed on one of the threads
+  void post(std::coroutine_handle<> handle)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mQueue.push_back(handle);
+    }
+    mCondition.notify_one();
+  }
+  std::size_t size() const { return mThreads.size(); }
+
+ private:
+  rc_thread_pool(const rc_thread_pool&); // forbidden
+  rc_thread_pool& operator=(const rc_thread_pool&); // forbidden
+
+  void run()
+  {
+    while (true) {
+      std::coroutine_handle<> handle;
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this]() { return mStop || !mQueue.empty(); });
+        if (mQueue.empty()) return;
+        handle = mQueue.front();
+        mQueue.pop_front();
+      }
+      handle.resume();
+    }
+  }
+
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::deque<std::coroutine_handle<>> mQueue;
+  std::vector<std::thread> mThreads;
+  bool mStop;
+};
+
+/**
+ * @brief Executor running the coroutine on the calling thread
+ */
+struct rc_inline_executor {
+  std::suspend_never schedule() const noexcept { return {}; }
+};
+
+/// result type of an asynchronous level functor, a returned task is awaited
+template <typename R>
+struct rc_async_result {
+  typedef R type;
+  static const bool awaitable = false;
+};
+template <typename U>
+struct rc_async_result<rc_task<U>> {
+  typedef U type;
+  static const bool awaitable = true;
+};
+
+/**
+ * @brief Apply the functor to the level at index on the executor
+ * An index out of range throws std::out_of_range when the task is awaited.
+ */
+template <typename Executor, typename ContainerT, typename F>
+rc_task<typename rc_async_result<typename F::return_type>::type> apply_async(Executor& executor,
+                                                                             ContainerT& container, int index, F f)
+{
+  typedef rc_async_result<typename F::return_type> result;
+  // the frame of a coroutine functor keeps the this pointer, the functor is
+  // dispatched by reference to the copy in this frame, which outlives the
+  // level coroutine
+  rc_functor_ref<F> functor(f);
+  co_await executor.schedule();
+  if constexpr (result::awaitable && std::is_void<typename result::type>::value) {
+    co_await container.template apply_bounded<rc_bounds_throw>(index, functor);
+  } else if constexpr (result::awaitable) {
+    co_return co_await container.template apply_bounded<rc_bounds_throw>(index, functor);
+  } else if constexpr (std::is_void<typename result::type>::value) {
+    container.template apply_bounded<rc_bounds_throw>(index, functor);
+  } else {
+    co_return container.template apply_bounded<rc_bounds_throw>(index, functor);
+  }
+}
+
+/**
+ * @brief Apply the functor to all levels concurrently on the executor
+ * The returned task completes when all levels are done, its result is the
+ * vector of the level results, or void.
+ */
+template <typename Executor, typename ContainerT, typename F>
+auto for_each_async(Executor& executor, ContainerT& container, F f)
+{
+  typedef typename rc_async_result<typename F::return_type>::type result_type;
+  std::vector<rc_task<result_type>> tasks;
+  tasks.reserve(container.size());
+  for (int index = 0; index < (int)container.size(); index++) {
+    tasks.push_back(apply_async(executor, container, index, f));
+  }
+  return rc_when_all(std::move(tasks));
+}
+
+}; // namespace gNeric
+
+#endif
@@ -0,0 +1,227 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_ATOMIC_H
+#define RC_ATOMIC_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_atomic.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Thread-safe member types for the runtime container
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// Member wrappers for concurrent updates of a shared runtime container from
+// multiple threads. Types for which std::atomic is lock-free are wrapped in
+// std::atomic, all other types are stored in a number of shards each
+// protected by a spin lock. The wrappers implement the operators used by
+// the set_value, add_value and get_value functors:
+// - operator+= is an atomic fetch_add with relaxed memory order
+// - operator= is a relaxed store
+// - conversion to the wrapped type is a relaxed load
+//
+// Usage: typedef create_rtc<rc_atomic_types<types>::type, base>::type container_type;
+//
+// Note: the tracking policy of the container is not thread-safe, containers
+// with atomic members should use the default no_tracking policy.
+
+#include <boost/mpl/transform.hpp>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace gNeric
+{
+/**
+ * @brief Check if std::atomic<T> is lock-free on all targets
+ * Before C++17, the check is approximated by the size of the type.
+ */
+template <typename T>
+struct rc_is_lock_free
+  : std::integral_constant<bool,
+#if __cplusplus >= 201703L
+                           std::atomic<T>::is_always_lock_free
+#else
+                           std::is_trivially_copyable<T>::value &&
+                             (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+#endif
+                           > {
+};
+
+/**
+ * @class atomic_member
+ * @brief Member wrapper using std::atomic
+ *
+ * Integral types use the native fetch_add, all other types a compare
+ * and exchange loop.
+ */
+template <typename T>
+class atomic_member
+{
+ public:
+  typedef T value_type;
+
+  atomic_member() : mValue(T()) {}
+  atomic_member(const atomic_member& other) : mValue(other.load()) {}
+  atomic_member& operator=(const atomic_member& other)
+  {
+    store(other.load());
+    return *this;
+  }
+  atomic_member& operator=(const T& v)
+  {
+    store(v);
+    return *this;
+  }
+
+  T load(std::memory_order order = std::memory_order_relaxed) const { return mValue.load(order); }
+  void store(T v, std::memory_order order = std::memory_order_relaxed) { mValue.store(v, order); }
+  operator T() const { return load(); }
+
+  /// atomic add, returns the previous value
+  T fetch_add(T v, std::memory_order order = std::memory_order_relaxed)
+  {
+    return fetch_add(v, order, std::is_integral<T>());
+  }
+  template <typename U>
+  atomic_member& operator+=(const U& v)
+  {
+    fetch_add(static_cast<T>(v));
+    return *this;
+  }
+
+ private:
+  T fetch_add(T v, std::memory_order order, std::true_type /*integral*/) { return mValue.fetch_add(v, order); }
+  T fetch_add(T v, std::memory_order order, std::false_type /*integral*/)
+  {
+    T expected = mValue.load(std::memory_order_relaxed);
+    while (!mValue.compare_exchange_weak(expected, expected + v, order, std::memory_order_relaxed)) {
+    }
+    return expected;
+  }
+
+  std::atomic<T> mValue;
+};
+
+/**
+ * @brief Slot of the calling thread, threads are numbered in the order of
+ * their first call
+ */
+inline std::size_t rc_thread_slot()
+{
+  static std::atomic<std::size_t> nThreads(0);
+  thread_local std::size_t slot = nThreads.fetch_add(1, std::memory_order_relaxed);
+  return slot;
+}
+
+/**
+ * @class sharded_member
+ * @brief Member wrapper for types without lock-free atomics
+ *
+ * The value is distributed over a number of shards on separate cache lines,
+ * each protected by a spin lock. A thread always updates the same shard,
+ * threads are assigned to the shards in round robin. Reading the value
+ * sums up all shards.
+ */
+template <typename T, std::size_t NShards = 16>
+class sharded_member
+{
+ public:
+  typedef T value_type;
+
+  sharded_member() : mShards() {}
+  sharded_member(const sharded_member& other) : mShards() { store(other.load()); }
+  sharded_member& operator=(const sharded_member& other)
+  {
+    store(other.load());
+    return *this;
+  }
+  sharded_member& operator=(const T& v)
+  {
+    store(v);
+    return *this;
+  }
+
+  T load() const
+  {
+    T sum = T();
+    for (auto& shard : mShards) {
+      lock_guard guard(shard);
+      sum += shard.value;
+    }
+    return sum;
+  }
+  void store(const T& v)
+  {
+    for (std::size_t i = 0; i < NShards; i++) {
+      lock_guard guard(mShards[i]);
+      mShards[i].value = i == 0 ? v : T();
+    }
+  }
+  operator T() const { return load(); }
+
+  template <typename U>
+  sharded_member& operator+=(const U& v)
+  {
+    shard& local = mShards[rc_thread_slot() % NShards];
+    lock_guard guard(local);
+    local.value += v;
+    return *this;
+  }
+
+ private:
+  // the shards are padded to separate cache lines instead of aligned, the
+  // containers are allocated with new, which does not support over-aligned
+  // types before C++17
+  struct shard {
+    shard() : value() { lock.clear(); }
+    mutable std::atomic_flag lock;
+    T value;
+    char padding[64];
+  };
+
+  class lock_guard
+  {
+   public:
+    lock_guard(const shard& s) : mShard(s)
+    {
+      while (mShard.lock.test_and_set(std::memory_order_acquire)) {
+      }
+    }
+    ~lock_guard() { mShard.lock.clear(std::memory_order_release); }
+
+   private:
+    const shard& mShard;
+  };
+
+  shard mShards[NShards];
+};
+
+/**
+ * @brief Select the thread-safe member wrapper for a type
+ */
+template <typename T>
+struct rc_atomic {
+  typedef typename std::conditional<rc_is_lock_free<T>::value, atomic_member<T>, sharded_member<T>>::type type;
+};
+
+/**
+ * @brief Transform a sequence of types into thread-safe member wrappers
+ */
+template <typename Types>
+struct rc_atomic_types {
+  typedef typename boost::mpl::transform<Types, rc_atomic<boost::mpl::placeholders::_1>>::type type;
+};
+
+}; // namespace gNeric
+
+#endif
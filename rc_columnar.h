@@ -0,0 +1,308 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_COLUMNAR_H
+#define RC_COLUMNAR_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_columnar.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Columnar binary format for sequences of runtime containers
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// A sequence of containers is written as a stream of blocks with one column
+// per level, every column holds the members of one level of all containers
+// of the block. The stream starts with a schema header:
+//
+//   header:  magic "GNRC", uint32 version, uint32 number of levels
+//            per level: uint32 member size, uint32 name length, name
+//   block:   uint32 number of rows
+//            per level: uint64 column size in bytes, column data
+//
+// The name of a level is the tag name if the tag has one, the type name
+// otherwise, see rc_reflection.h. The reader throws if the number of levels,
+// a member size or a level name differs from the container. It loads only
+// the selected levels and seeks over the other columns, the data read scales
+// with the selected columns. All members have to be trivially copyable and stored in the
+// container, lazy levels are not supported: the columns are copied from and
+// to the storage of the members, which is not constructed for an unengaged
+// lazy level. The data is written in native byte order.
+//
+// Usage:
+//   rc_column_writer<container_type> writer(out);
+//   writer.write(containers.begin(), containers.end());
+//   writer.flush();
+//
+//   rc_column_reader<container_type> reader(in);
+//   reader.select({0, 3});
+//   std::vector<container_type> block;
+//   while (reader.read(block) > 0) { ... }
+
+#include "rc_reflection.h"
+#include <boost/mpl/count_if.hpp>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace gNeric
+{
+/**
+ * @brief check if the member of a container level is trivially copyable and not lazy
+ */
+template <typename Stage>
+struct rc_trivially_copyable
+  : boost::mpl::bool_<
+      std::is_trivially_copyable<typename Stage::wrapped_type>::value &&
+      std::is_same<typename Stage::storage_type, rc_eager_storage<typename Stage::wrapped_type>>::value> {
+};
+
+/**
+ * @brief Schema of the columnar format
+ */
+template <typename ContainerT>
+struct rc_column_schema {
+  typedef rc_reflection<ContainerT> reflection;
+  static const std::size_t N = reflection::N;
+  static_assert(boost::mpl::count_if<typename ContainerT::types, rc_trivially_copyable<_1>>::value == N,
+                "columnar format requires trivially copyable members and no lazy levels");
+
+  static const std::uint32_t version = 1;
+  static const char* magic() { return "GNRC"; }
+
+  /// name of a level in the schema
+  static const char* level_name(int index)
+  {
+    const rc_level_info& info = reflection::level(index);
+    return info.tag_name ? info.tag_name : info.type_name;
+  }
+};
+
+/**
+ * @class rc_column_writer
+ * @brief Streaming writer of containers into column blocks
+ *
+ * The containers are collected in column buffers, a block is written when
+ * the buffers hold blockSize rows, and by flush.
+ */
+template <typename ContainerT>
+class rc_column_writer
+{
+ public:
+  typedef rc_column_schema<ContainerT> schema;
+  static const std::size_t N = schema::N;
+
+  rc_column_writer(std::ostream& out, std::uint32_t blockSize = 65536)
+    : mOut(out), mBlockSize(blockSize > 0 ? blockSize : 1), mRows(0), mColumns(N)
+  {
+    for (std::size_t level = 0; level < N; level++) {
+      mColumns[level].reserve(mBlockSize * schema::reflection::level(level).size);
+    }
+    write_header();
+  }
+  ~rc_column_writer() { flush(); }
+
+  /// append one container
+  void write(const ContainerT& container)
+  {
+    for (std::size_t level = 0; level < N; level++) {
+      const char* member = static_cast<const char*>(schema::reflection::address(container, level));
+      mColumns[level].insert(mColumns[level].end(), member, member + schema::reflection::level(level).size);
+    }
+    if (++mRows == mBlockSize) flush();
+  }
+
+  /// append a range of containers
+  template <typename Iterator>
+  void write(Iterator begin, Iterator end)
+  {
+    for (; begin != end; ++begin) write(*begin);
+  }
+
+  /// write the pending rows as one block
+  void flush()
+  {
+    if (mRows == 0) return;
+    write_value(mRows);
+    for (auto& column : mColumns) {
+      write_value(static_cast<std::uint64_t>(column.size()));
+      mOut.write(column.data(), column.size());
+      column.clear();
+    }
+    mRows = 0;
+    mOut.flush();
+  }
+
+ private:
+  rc_column_writer(const rc_column_writer&); // forbidden
+  rc_column_writer& operator=(const rc_column_writer&); // forbidden
+
+  template <typename T>
+  void write_value(T value)
+  {
+    mOut.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void write_header()
+  {
+    mOut.write(schema::magic(), 4);
+    write_value(schema::version);
+    write_value(static_cast<std::uint32_t>(N));
+    for (std::size_t level = 0; level < N; level++) {
+      const char* name = schema::level_name(level);
+      write_value(static_cast<std::uint32_t>(schema::reflection::level(level).size));
+      write_value(static_cast<std::uint32_t>(std::strlen(name)));
+      mOut.write(name, std::strlen(name));
+    }
+  }
+
+  std::ostream& mOut;
+  std::uint32_t mBlockSize;
+  std::uint32_t mRows;
+  std::vector<std::vector<char>> mColumns;
+};
+
+/**
+ * @class rc_column_reader
+ * @brief Block-wise reader of the columnar format
+ *
+ * The header is checked against the container type, a mismatch of the
+ * number of levels or the member sizes throws std::runtime_error. The
+ * columns of the selected levels are loaded with next and can be accessed
+ * directly with column, or copied into containers with fill. Levels which
+ * are not selected keep the state of a default constructed container.
+ */
+template <typename ContainerT>
+class rc_column_reader
+{
+ public:
+  typedef rc_column_schema<ContainerT> schema;
+  static const std::size_t N = schema::N;
+
+  rc_column_reader(std::istream& in) : mIn(in), mSelected(N, true), mRows(0), mColumns(N), mNames(N)
+  {
+    read_header();
+  }
+
+  /// select the levels to be read, all levels by default
+  void select(const std::vector<int>& levels)
+  {
+    mSelected.assign(N, false);
+    for (int level : levels) {
+      if (level < 0 || level >= (int)N) throw std::out_of_range("rc_column_reader: invalid level");
+      mSelected[level] = true;
+    }
+  }
+  /// name of a level as stored in the schema header
+  const std::string& level_name(int level) const { return mNames[level]; }
+
+  /// load the next block, returns the number of rows, 0 at the end of the stream
+  std::size_t next()
+  {
+    std::uint32_t rows = 0;
+    if (!read_value(rows)) return mRows = 0;
+    for (std::size_t level = 0; level < N; level++) {
+      std::uint64_t size = 0;
+      if (!read_value(size) || size != rows * schema::reflection::level(level).size) {
+        throw std::runtime_error("rc_column_reader: corrupted block");
+      }
+      if (mSelected[level]) {
+        mColumns[level].resize(size);
+        mIn.read(mColumns[level].data(), size);
+      } else {
+        mIn.seekg(size, std::ios_base::cur);
+      }
+      if (!mIn) throw std::runtime_error("rc_column_reader: truncated block");
+    }
+    return mRows = rows;
+  }
+
+  /// the column of a selected level in the current block
+  template <typename T>
+  const T* column(int level) const
+  {
+    return reinterpret_cast<const T*>(mColumns[level].data());
+  }
+
+  /// copy the current block into containers, the vector is resized to the block
+  void fill(std::vector<ContainerT>& containers) const
+  {
+    containers.assign(mRows, ContainerT());
+    for (std::size_t level = 0; level < N; level++) {
+      if (!mSelected[level]) continue;
+      const std::size_t size = schema::reflection::level(level).size;
+      const char* data = mColumns[level].data();
+      for (std::size_t row = 0; row < mRows; row++) {
+        std::memcpy(schema::reflection::address(containers[row], level), data + row * size, size);
+      }
+    }
+  }
+
+  /// load the next block into containers, returns the number of rows
+  std::size_t read(std::vector<ContainerT>& containers)
+  {
+    std::size_t rows = next();
+    fill(containers);
+    return rows;
+  }
+
+ private:
+  rc_column_reader(const rc_column_reader&); // forbidden
+  rc_column_reader& operator=(const rc_column_reader&); // forbidden
+
+  template <typename T>
+  bool read_value(T& value)
+  {
+    mIn.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return mIn.gcount() == sizeof(T);
+  }
+
+  void read_header()
+  {
+    char magic[4];
+    std::uint32_t version = 0, levels = 0;
+    mIn.read(magic, 4);
+    if (!mIn || std::memcmp(magic, schema::magic(), 4) != 0 || !read_value(version) ||
+        version != schema::version) {
+      throw std::runtime_error("rc_column_reader: not a columnar container stream");
+    }
+    if (!read_value(levels) || levels != N) {
+      throw std::runtime_error("rc_column_reader: number of levels does not match the container");
+    }
+    for (std::size_t level = 0; level < N; level++) {
+      std::uint32_t size = 0, length = 0;
+      if (!read_value(size) || !read_value(length) || size != schema::reflection::level(level).size) {
+        throw std::runtime_error("rc_column_reader: member size does not match the container");
+      }
+      mNames[level].resize(length);
+      mIn.read(&mNames[level][0], length);
+      if (mIn.gcount() != static_cast<std::streamsize>(length) || mNames[level] != schema::level_name(level)) {
+        throw std::runtime_error("rc_column_reader: level name does not match the container");
+      }
+    }
+  }
+
+  std::istream& mIn;
+  std::vector<bool> mSelected;
+  std::size_t mRows;
+  std::vector<std::vector<char>> mColumns;
+  std::vector<std::string> mNames;
+};
+
+}; // namespace gNeric
+
+#endif
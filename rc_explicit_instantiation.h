@@ -0,0 +1,85 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_EXPLICIT_INSTANTIATION_H
+#define RC_EXPLICIT_INSTANTIATION_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_explicit_instantiation.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Explicit instantiation of container functions for chosen functors
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// Every translation unit calling apply or for_each of a container with a
+// functor instantiates the dispatch, i.e. the rc_apply_at recursion over all
+// levels, and the functor for every level. With many translation units and
+// heavy containers this dominates the build time and the code size before
+// the linker removes the duplicates.
+//
+// The EXTERN macros declare the functions for a container and functor as
+// explicitly instantiated elsewhere, they go into the header which defines
+// the container type. The INSTANTIATE macros go into exactly one source file
+// and instantiate the functions there.
+//
+// Usage, in the header:
+//   typedef create_rtc<types, RuntimeContainer<> >::type container_type;
+//   RC_EXTERN_FUNCTOR(container_type, fill_levels)
+// in one source file:
+//   RC_INSTANTIATE_FUNCTOR(container_type, fill_levels)
+//
+// The macros are used at global namespace scope with typedef names, which
+// must not contain commas, and qualified names for types in namespaces.
+// The types of the container are still computed in every translation unit,
+// the saving is in the function bodies. The declarations do not prevent
+// inlining: with optimization, gcc still instantiates the functions in the
+// calling unit to inline them, and the explicit instantiations come on top.
+//
+// Use the EXTERN macros only for builds without optimization, e.g. debug
+// builds, and define RC_NO_EXTERN_TEMPLATES for optimized builds. Measured
+// with bench_instantiation.sh, 8 units, g++ 12, extern vs implicit:
+//   -O0  compile time -11%, objects .text 128 vs 365 kB, program .text +10%
+//   -O2  compile time +17%, objects .text 83 vs 73 kB, program .text +16%
+// At -O2 the extern build is worse in every number. Defining
+// RC_NO_EXTERN_TEMPLATES turns the EXTERN macros off.
+//
+// See instantiation_demo.h and bench_instantiation.sh for a measurement.
+
+#include "runtime_container.h"
+
+/// apply(index, f) with the bounds policy RC_BOUNDS_POLICY
+#define RC_INSTANTIATE_APPLY(ContainerT, F) template F::return_type ContainerT::apply<F>(int, F);
+/// apply_bounded<Bounds>(index, f)
+#define RC_INSTANTIATE_APPLY_BOUNDED(ContainerT, Bounds, F) \
+  template F::return_type ContainerT::apply_bounded<Bounds, F>(int, F);
+/// for_each(f)
+#define RC_INSTANTIATE_FOR_EACH(ContainerT, F) template void ContainerT::for_each<F>(F);
+/// apply and for_each
+#define RC_INSTANTIATE_FUNCTOR(ContainerT, F) \
+  RC_INSTANTIATE_APPLY(ContainerT, F)         \
+  RC_INSTANTIATE_FOR_EACH(ContainerT, F)
+
+#ifndef RC_NO_EXTERN_TEMPLATES
+#define RC_EXTERN_APPLY(ContainerT, F) extern RC_INSTANTIATE_APPLY(ContainerT, F)
+#define RC_EXTERN_APPLY_BOUNDED(ContainerT, Bounds, F) extern RC_INSTANTIATE_APPLY_BOUNDED(ContainerT, Bounds, F)
+#define RC_EXTERN_FOR_EACH(ContainerT, F) extern RC_INSTANTIATE_FOR_EACH(ContainerT, F)
+#define RC_EXTERN_FUNCTOR(ContainerT, F) \
+  RC_EXTERN_APPLY(ContainerT, F)         \
+  RC_EXTERN_FOR_EACH(ContainerT, F)
+#else
+#define RC_EXTERN_APPLY(ContainerT, F)
+#define RC_EXTERN_APPLY_BOUNDED(ContainerT, Bounds, F)
+#define RC_EXTERN_FOR_EACH(ContainerT, F)
+#define RC_EXTERN_FUNCTOR(ContainerT, F)
+#endif
+
+#endif
@@ -0,0 +1,382 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_EXPRESSION_H
+#define RC_EXPRESSION_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_expression.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Expression templates for arithmetic with whole runtime containers
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// The arithmetic operators +, -, * and / applied to runtime containers and
+// arithmetic scalars build an expression type, no calculation is done and no
+// temporary container is created. The assignment of the expression to a
+// container evaluates the expression level by level:
+//
+//   c = a + 2 * b;
+//
+// For levels with std::vector or std::array members, the expression is
+// evaluated element-wise in one loop per level, the vectors of the target are
+// resized to the size of the operands. All vector operands of a level must
+// have the same size, std::length_error is thrown otherwise. The container
+// operands must have the type of the target container. The operands of an
+// expression are referenced, the containers have to outlive the expression.
+//
+// Requires C++14.
+
+#include "runtime_container.h"
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace gNeric
+{
+/// members which are evaluated element-wise
+template <typename T>
+struct rc_is_column : std::false_type {
+};
+template <typename T, typename A>
+struct rc_is_column<std::vector<T, A>> : std::true_type {
+};
+template <typename T, std::size_t N>
+struct rc_is_column<std::array<T, N>> : std::true_type {
+};
+
+/**
+ * @brief Evaluators of an expression bound to one level
+ * The evaluator of a level accesses the columns through plain pointers, the
+ * evaluation loop can be vectorized by the compiler.
+ */
+template <typename T>
+struct rc_bound_value {
+  const T& at(std::size_t) const { return value; }
+  T value;
+};
+template <typename T>
+struct rc_bound_column {
+  const T& at(std::size_t i) const { return data[i]; }
+  const T* data;
+};
+template <typename Op, typename L, typename R>
+struct rc_bound_binary {
+  auto at(std::size_t i) const { return Op::apply(left.at(i), right.at(i)); }
+  L left;
+  R right;
+};
+
+/// size of the operands without elements, scalars and scalar members
+constexpr std::size_t rc_no_size = ~std::size_t(0);
+
+template <typename T>
+std::size_t rc_column_size(const T& member)
+{
+  return member.size();
+}
+/// the size of two operands of a level, column operands must have the same size
+inline std::size_t rc_common_size(std::size_t left, std::size_t right)
+{
+  if (left == rc_no_size) return right;
+  if (right != rc_no_size && right != left) throw std::length_error("rc_expression: column operands of different size");
+  return left;
+}
+template <typename T, typename A>
+void rc_resize(std::vector<T, A>& member, std::size_t size)
+{
+  member.resize(size);
+}
+template <typename T, std::size_t N>
+void rc_resize(std::array<T, N>&, std::size_t)
+{
+}
+
+/**
+ * @class rc_expression
+ * @brief CRTP base of all expression types
+ */
+template <typename E>
+class rc_expression
+{
+ public:
+  const E& self() const { return static_cast<const E&>(*this); }
+};
+
+/**
+ * @brief Container operand of an expression
+ */
+template <typename ContainerT>
+class rc_terminal : public rc_expression<rc_terminal<ContainerT>>
+{
+ public:
+  rc_terminal(const ContainerT& container) : mContainer(container) {}
+
+  /// evaluator for level Stage
+  template <typename Stage>
+  auto bind() const
+  {
+    return bind(member<Stage>(), rc_is_column<typename Stage::wrapped_type>());
+  }
+  /// number of elements of the member of level Stage, rc_no_size for scalar members
+  template <typename Stage>
+  std::size_t size() const
+  {
+    return size(member<Stage>(), rc_is_column<typename Stage::wrapped_type>());
+  }
+  /// check if the operand can be evaluated for the levels of the target
+  template <typename TargetT>
+  static constexpr bool matches()
+  {
+    return std::is_same<typename ContainerT::mixin_type, typename TargetT::mixin_type>::value;
+  }
+
+ private:
+  template <typename Stage>
+  const typename Stage::wrapped_type& member() const
+  {
+    static_assert(std::is_base_of<Stage, ContainerT>::value, "operand container does not have the level of the target");
+    return *static_cast<const Stage&>(mContainer);
+  }
+  template <typename T>
+  static rc_bound_value<T> bind(const T& member, std::false_type)
+  {
+    return {member};
+  }
+  template <typename T>
+  static rc_bound_column<typename T::value_type> bind(const T& member, std::true_type)
+  {
+    return {member.data()};
+  }
+  template <typename T>
+  static std::size_t size(const T&, std::false_type)
+  {
+    return rc_no_size;
+  }
+  template <typename T>
+  static std::size_t size(const T& member, std::true_type)
+  {
+    return rc_column_size(member);
+  }
+
+  const ContainerT& mContainer;
+};
+
+/**
+ * @brief Scalar operand of an expression, the same for all levels and elements
+ */
+template <typename T>
+class rc_scalar : public rc_expression<rc_scalar<T>>
+{
+ public:
+  rc_scalar(const T& value) : mValue(value) {}
+
+  template <typename Stage>
+  rc_bound_value<T> bind() const
+  {
+    return {mValue};
+  }
+  template <typename Stage>
+  std::size_t size() const
+  {
+    return rc_no_size;
+  }
+  template <typename TargetT>
+  static constexpr bool matches()
+  {
+    return true;
+  }
+
+ private:
+  T mValue;
+};
+
+/**
+ * @brief Binary operation of two expressions
+ */
+template <typename Op, typename L, typename R>
+class rc_binary : public rc_expression<rc_binary<Op, L, R>>
+{
+ public:
+  rc_binary(const L& left, const R& right) : mLeft(left), mRight(right) {}
+
+  template <typename Stage>
+  auto bind() const
+  {
+    auto left = mLeft.template bind<Stage>();
+    auto right = mRight.template bind<Stage>();
+    return rc_bound_binary<Op, decltype(left), decltype(right)>{left, right};
+  }
+  /// the size of the operands, throws std::length_error if the column operands differ
+  template <typename Stage>
+  std::size_t size() const
+  {
+    return rc_common_size(mLeft.template size<Stage>(), mRight.template size<Stage>());
+  }
+  template <typename TargetT>
+  static constexpr bool matches()
+  {
+    return L::template matches<TargetT>() && R::template matches<TargetT>();
+  }
+
+ private:
+  L mLeft;
+  R mRight;
+};
+
+struct rc_plus {
+  template <typename A, typename B>
+  static auto apply(const A& a, const B& b)
+  {
+    return a + b;
+  }
+};
+struct rc_minus {
+  template <typename A, typename B>
+  static auto apply(const A& a, const B& b)
+  {
+    return a - b;
+  }
+};
+struct rc_multiplies {
+  template <typename A, typename B>
+  static auto apply(const A& a, const B& b)
+  {
+    return a * b;
+  }
+};
+struct rc_divides {
+  template <typename A, typename B>
+  static auto apply(const A& a, const B& b)
+  {
+    return a / b;
+  }
+};
+
+/// check if a type is a runtime container
+template <typename T, typename = void>
+struct rc_is_container : std::false_type {
+};
+template <typename T>
+struct rc_is_container<T, typename std::conditional<false, typename T::mixin_type, void>::type> : std::true_type {
+};
+
+/**
+ * @brief Expression type of an operand: expressions are used as they are,
+ * containers are wrapped in a terminal and arithmetic types in a scalar
+ */
+template <typename T, typename = void>
+struct rc_operand {
+  static const bool expression = false;
+  typedef void type;
+};
+template <typename T>
+struct rc_operand<T, typename std::enable_if<std::is_base_of<rc_expression<T>, T>::value>::type> {
+  static const bool expression = true;
+  typedef T type;
+  static const T& make(const T& t) { return t; }
+};
+template <typename T>
+struct rc_operand<T, typename std::enable_if<rc_is_container<T>::value>::type> {
+  static const bool expression = true;
+  typedef rc_terminal<T> type;
+  static type make(const T& t) { return type(t); }
+};
+template <typename T>
+struct rc_operand<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+  static const bool expression = false;
+  typedef rc_scalar<T> type;
+  static type make(const T& t) { return type(t); }
+};
+
+/// the binary expression of the operands, enabled if at least one operand
+/// is a container or an expression
+template <typename Op, typename L, typename R>
+struct rc_make_binary
+  : std::enable_if<(rc_operand<L>::expression || rc_operand<R>::expression) &&
+                     !std::is_same<typename rc_operand<L>::type, void>::value &&
+                     !std::is_same<typename rc_operand<R>::type, void>::value,
+                   rc_binary<Op, typename rc_operand<L>::type, typename rc_operand<R>::type>> {
+};
+
+template <typename L, typename R>
+typename rc_make_binary<rc_plus, L, R>::type operator+(const L& l, const R& r)
+{
+  return {rc_operand<L>::make(l), rc_operand<R>::make(r)};
+}
+template <typename L, typename R>
+typename rc_make_binary<rc_minus, L, R>::type operator-(const L& l, const R& r)
+{
+  return {rc_operand<L>::make(l), rc_operand<R>::make(r)};
+}
+template <typename L, typename R>
+typename rc_make_binary<rc_multiplies, L, R>::type operator*(const L& l, const R& r)
+{
+  return {rc_operand<L>::make(l), rc_operand<R>::make(r)};
+}
+template <typename L, typename R>
+typename rc_make_binary<rc_divides, L, R>::type operator/(const L& l, const R& r)
+{
+  return {rc_operand<L>::make(l), rc_operand<R>::make(r)};
+}
+
+/**
+ * @brief Evaluate the expression for one level of the target container
+ */
+template <typename E>
+class rc_assign_level
+{
+ public:
+  typedef void return_type;
+  rc_assign_level(const E& expression) : mExpression(expression) {}
+
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    assign<T>(stage.modify(), rc_is_column<typename T::wrapped_type>());
+  }
+
+ private:
+  template <typename Stage, typename M>
+  void assign(M& member, std::false_type /*column*/)
+  {
+    member = mExpression.template bind<Stage>().at(0);
+  }
+  template <typename Stage, typename M>
+  void assign(M& member, std::true_type /*column*/)
+  {
+    const std::size_t size = mExpression.template size<Stage>();
+    rc_resize(member, size);
+    const auto evaluator = mExpression.template bind<Stage>();
+    auto* target = member.data();
+    for (std::size_t i = 0; i < size; i++) {
+      target[i] = evaluator.at(i);
+    }
+  }
+
+  const E& mExpression;
+};
+
+/// evaluate the expression into the container, called by the assignment
+/// operator of the container
+template <typename ContainerT, typename E>
+void rc_assign(ContainerT& container, const E& expression)
+{
+  static_assert(E::template matches<ContainerT>(), "the operand containers must have the type of the target container");
+  container.for_each(rc_assign_level<E>(expression));
+}
+
+}; // namespace gNeric
+
+#endif
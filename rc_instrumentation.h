@@ -0,0 +1,253 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_INSTRUMENTATION_H
+#define RC_INSTRUMENTATION_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_instrumentation.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Per-level timing of apply and for_each
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// The instrumentation policy of RuntimeContainer opens a scope around every
+// functor call of apply and for_each. The default policy no_instrumentation,
+// defined in runtime_container.h, has an empty scope and compiles to nothing.
+// With rc_timing_instrumentation the scope counts the calls and the clock
+// ticks per level in a table of the calling thread, no synchronization is
+// needed on the hot path.
+//
+// Usage:
+//   typedef rc_timing_instrumentation<> instrumentation;
+//   typedef RuntimeContainer<DefaultInterface, default_initializer, default_printer, no_tracking,
+//                            instrumentation> base;
+//   typedef create_rtc<types, base>::type container_type;
+//   ...
+//   rc_timing_table table = instrumentation::collect();
+//   rc_write_csv(std::cout, table, rc_level_names<container_type>());
+//   rc_write_collapsed(std::cout, table, "container", rc_level_names<container_type>());
+//
+// collect sums the tables of all threads, call it after the worker threads
+// have finished. The collapsed format has one line 'root;level ticks' per
+// level and can be read by flame graph tools like flamegraph.pl. A functor
+// calling apply on another level is counted for both levels. Containers of
+// different types can use separate tables by the Tag parameter.
+//
+// The default clock rc_tsc_clock reads the time stamp counter on x86 and
+// falls back to std::chrono::steady_clock in ns on other architectures.
+
+#include "rc_reflection.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace gNeric
+{
+/**
+ * @brief Time stamp counter, steady_clock in ns if not available
+ */
+struct rc_tsc_clock {
+  static std::uint64_t now()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+  }
+  static const char* unit()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return "cycles";
+#else
+    return "ns";
+#endif
+  }
+};
+
+/**
+ * @brief steady_clock in ns
+ */
+struct rc_steady_clock {
+  static std::uint64_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+  }
+  static const char* unit() { return "ns"; }
+};
+
+/**
+ * @brief Counters of a level
+ */
+struct rc_level_counters {
+  std::uint64_t calls; // number of functor calls
+  std::uint64_t ticks; // clock ticks in the functor calls
+};
+
+/**
+ * @class rc_timing_table
+ * @brief Counters of all levels, grows with the highest recorded level
+ */
+class rc_timing_table
+{
+ public:
+  rc_timing_table() : mCounters(), mUnit("ticks") {}
+  explicit rc_timing_table(const char* unit) : mCounters(), mUnit(unit) {}
+
+  void record(int level, std::uint64_t ticks)
+  {
+    if (level < 0) return;
+    if ((std::size_t)level >= mCounters.size()) mCounters.resize(level + 1, rc_level_counters{0, 0});
+    mCounters[level].calls++;
+    mCounters[level].ticks += ticks;
+  }
+  /// add the counters of another table
+  void merge(const rc_timing_table& other)
+  {
+    if (other.mCounters.size() > mCounters.size()) mCounters.resize(other.mCounters.size(), rc_level_counters{0, 0});
+    for (std::size_t i = 0; i < other.mCounters.size(); i++) {
+      mCounters[i].calls += other.mCounters[i].calls;
+      mCounters[i].ticks += other.mCounters[i].ticks;
+    }
+  }
+  void clear() { mCounters.clear(); }
+
+  std::size_t size() const { return mCounters.size(); }
+  const rc_level_counters& operator[](std::size_t level) const { return mCounters[level]; }
+  const char* unit() const { return mUnit; }
+
+ private:
+  std::vector<rc_level_counters> mCounters;
+  const char* mUnit;
+};
+
+/**
+ * @brief Instrumentation policy with per-level timing in per-thread tables
+ *
+ * @tparam Clock  clock with static now() and unit(), see rc_tsc_clock
+ * @tparam Tag    separates the tables of different containers
+ */
+template <typename Clock = rc_tsc_clock, typename Tag = void>
+struct rc_timing_instrumentation {
+  typedef Clock clock_type;
+
+  /// records the call of a level when it goes out of scope
+  class scope
+  {
+   public:
+    explicit scope(int level) : mLevel(level), mBegin(Clock::now()) {}
+    ~scope() { local().record(mLevel, Clock::now() - mBegin); }
+
+   private:
+    scope(const scope&); // forbidden
+    scope& operator=(const scope&); // forbidden
+    int mLevel;
+    std::uint64_t mBegin;
+  };
+
+  /// table of the calling thread
+  static rc_timing_table& local()
+  {
+    thread_local std::shared_ptr<rc_timing_table> table = add_table();
+    return *table;
+  }
+
+  /// sum of the tables of all threads, the tables of finished threads are kept
+  static rc_timing_table collect()
+  {
+    rc_timing_table result(Clock::unit());
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    for (auto& table : registry()) result.merge(*table);
+    return result;
+  }
+
+  /// clear the tables of all threads
+  static void clear()
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    for (auto& table : registry()) table->clear();
+  }
+
+ private:
+  static std::shared_ptr<rc_timing_table> add_table()
+  {
+    std::shared_ptr<rc_timing_table> table(new rc_timing_table(Clock::unit()));
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    registry().push_back(table);
+    return table;
+  }
+  static std::mutex& registry_mutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+  static std::vector<std::shared_ptr<rc_timing_table>>& registry()
+  {
+    static std::vector<std::shared_ptr<rc_timing_table>> tables;
+    return tables;
+  }
+};
+
+/// names of the levels of a container: the tag name or the type name
+template <typename ContainerT>
+std::vector<std::string> rc_level_names()
+{
+  std::vector<std::string> names;
+  for (auto& info : rc_reflection<ContainerT>::levels()) {
+    names.push_back(info.tag_name != nullptr ? info.tag_name : info.type_name);
+  }
+  return names;
+}
+
+/// name of a level for the export, the index if there is no name
+inline std::string rc_level_name(const std::vector<std::string>& names, std::size_t level)
+{
+  return level < names.size() ? names[level] : "level_" + std::to_string(level);
+}
+
+/// write the table as CSV with one line per called level
+inline void rc_write_csv(std::ostream& out, const rc_timing_table& table,
+                         const std::vector<std::string>& names = std::vector<std::string>())
+{
+  out << "level,name,calls," << table.unit() << "," << table.unit() << "_per_call" << std::endl;
+  for (std::size_t level = 0; level < table.size(); level++) {
+    const rc_level_counters& counters = table[level];
+    if (counters.calls == 0) continue;
+    out << level << ",\"" << rc_level_name(names, level) << "\"," << counters.calls << "," << counters.ticks << ","
+        << (double)counters.ticks / counters.calls << std::endl;
+  }
+}
+
+/// write the table in the collapsed stack format of flame graph tools
+inline void rc_write_collapsed(std::ostream& out, const rc_timing_table& table, const std::string& root,
+                               const std::vector<std::string>& names = std::vector<std::string>())
+{
+  for (std::size_t level = 0; level < table.size(); level++) {
+    const rc_level_counters& counters = table[level];
+    if (counters.calls == 0) continue;
+    out << root << ";" << rc_level_name(names, level) << " " << counters.ticks << std::endl;
+  }
+}
+
+}; // namespace gNeric
+
+#endif
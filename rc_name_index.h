@@ -0,0 +1,248 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_NAME_INDEX_H
+#define RC_NAME_INDEX_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_name_index.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Lookup of runtime container levels by name
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// Maps the names of the levels of a runtime container to the level index by
+// a perfect hash table which is computed at compile time. The levels are
+// defined with tagged<Tag, T>, every tag provides its name by a static
+// constexpr function:
+//
+//   struct energy_tag { static constexpr const char* name() { return "energy"; } };
+//
+// The lookup hashes the name once (FNV-1a, 64 bit) and reads one slot of the
+// table, the stored hash of the slot is compared instead of the strings. A
+// name which is not a level name is rejected unless its 64 bit hash collides
+// with a level name.
+//
+// Usage:
+//   int index = rc_name_index<container_type>::find(name);
+//   if (index >= 0) container.apply(index, f);
+//
+// Requires C++14.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/size.hpp>
+
+namespace gNeric
+{
+/// FNV-1a hash of a zero terminated string
+constexpr std::uint64_t rc_name_hash(const char* name)
+{
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  while (*name) {
+    hash ^= static_cast<unsigned char>(*name++);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+/// FNV-1a hash of a string with length
+constexpr std::uint64_t rc_name_hash(const char* name, std::size_t length)
+{
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  for (std::size_t i = 0; i < length; i++) {
+    hash ^= static_cast<unsigned char>(name[i]);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+/**
+ * @class rc_perfect_hash
+ * @brief Perfect hash table of N keys, built at compile time
+ *
+ * The keys are 64 bit hashes. The table has the next power of two of at
+ * least 2N slots, the keys are placed by hash and displace: a key is first
+ * mapped to one of about N/2 buckets, every bucket has a seed which maps its
+ * keys to free slots. The buckets are placed in the order of decreasing size,
+ * the seed of a bucket is searched until all of its keys find a free slot.
+ * A lookup computes two hashes of the key and reads one slot. The keys have
+ * to be different, a table of duplicate keys stays empty.
+ */
+template <std::size_t N>
+class rc_perfect_hash
+{
+ public:
+  static constexpr std::size_t next_pow2(std::size_t n, std::size_t bits = 1)
+  {
+    return (std::size_t(1) << bits) >= n ? bits : next_pow2(n, bits + 1);
+  }
+  static constexpr std::size_t Bits = next_pow2(2 * N);
+  static constexpr std::size_t Size = std::size_t(1) << Bits;
+  static constexpr std::size_t BucketBits = next_pow2((N + 1) / 2);
+  static constexpr std::size_t Buckets = std::size_t(1) << BucketBits;
+
+  constexpr rc_perfect_hash(const std::uint64_t (&keys)[N]) : mSeeds(), mHashes(), mIndices()
+  {
+    for (std::size_t slot = 0; slot < Size; slot++) {
+      mIndices[slot] = -1;
+    }
+    if (!unique(keys)) return;
+    std::size_t buckets[N] = {};
+    std::size_t counts[Buckets] = {};
+    for (std::size_t i = 0; i < N; i++) {
+      buckets[i] = position(keys[i], 0, BucketBits);
+      counts[buckets[i]]++;
+    }
+    for (std::size_t count = N; count > 0; count--) {
+      for (std::size_t bucket = 0; bucket < Buckets; bucket++) {
+        if (counts[bucket] == count) place(keys, buckets, bucket);
+      }
+    }
+  }
+
+  /// all keys differ, the seed search of place does not end otherwise
+  static constexpr bool unique(const std::uint64_t (&keys)[N])
+  {
+    for (std::size_t i = 0; i < N; i++) {
+      for (std::size_t j = i + 1; j < N; j++) {
+        if (keys[i] == keys[j]) return false;
+      }
+    }
+    return true;
+  }
+
+  /// index of the key, -1 if not found
+  constexpr int find(std::uint64_t key) const
+  {
+    std::size_t slot = position(key, mSeeds[position(key, 0, BucketBits)], Bits);
+    return mIndices[slot] >= 0 && mHashes[slot] == key ? mIndices[slot] : -1;
+  }
+
+ private:
+  /// multiplicative hash of key and seed, the top bits
+  static constexpr std::size_t position(std::uint64_t key, std::uint64_t seed, std::size_t bits)
+  {
+    return static_cast<std::size_t>(((key ^ seed) * 0x9e3779b97f4a7c15ull) >> (64 - bits));
+  }
+
+  /// search the seed of a bucket for which all of its keys find a free slot
+  constexpr void place(const std::uint64_t (&keys)[N], const std::size_t (&buckets)[N], std::size_t bucket)
+  {
+    // the candidates differ in all bits, the keys of a bucket share the top bits
+    for (std::uint64_t seed = 0xbf58476d1ce4e5b9ull;; seed += 0xbf58476d1ce4e5b9ull) {
+      std::size_t placed = 0;
+      bool collision = false;
+      for (std::size_t i = 0; i < N && !collision; i++) {
+        if (buckets[i] != bucket) continue;
+        std::size_t slot = position(keys[i], seed, Bits);
+        if (mIndices[slot] >= 0) {
+          collision = true;
+        } else {
+          mIndices[slot] = i;
+          mHashes[slot] = keys[i];
+          placed++;
+        }
+      }
+      if (!collision) {
+        mSeeds[bucket] = seed;
+        return;
+      }
+      // remove the keys of this bucket placed with the seed
+      for (std::size_t i = 0; i < N && placed > 0; i++) {
+        if (buckets[i] != bucket) continue;
+        std::size_t slot = position(keys[i], seed, Bits);
+        if (mIndices[slot] == (int)i) {
+          mIndices[slot] = -1;
+          placed--;
+        }
+      }
+    }
+  }
+
+  std::uint64_t mSeeds[Buckets];
+  std::uint64_t mHashes[Size];
+  int mIndices[Size];
+};
+
+/// the table without keys
+template <>
+class rc_perfect_hash<0>
+{
+ public:
+  constexpr rc_perfect_hash() {}
+  constexpr int find(std::uint64_t) const { return -1; }
+};
+
+/**
+ * @class rc_name_index
+ * @brief Name to index lookup for the levels of a runtime container
+ *
+ * All levels have to be tagged, the tag provides the name of the level. The
+ * names have to be unique, checked at compile time.
+ */
+template <typename ContainerT>
+class rc_name_index
+{
+ public:
+  typedef typename ContainerT::types types;
+  static constexpr std::size_t N = boost::mpl::size<types>::value;
+
+  /// name of the level at index
+  static const char* name(int index) { return names(std::make_index_sequence<N>())[index]; }
+
+  /// index of the level with name, -1 if not found
+  static constexpr int find(const char* name) { return sTable.find(rc_name_hash(name)); }
+  static int find(const std::string& name) { return sTable.find(rc_name_hash(name.data(), name.size())); }
+
+ private:
+  template <std::size_t I>
+  static constexpr const char* level_name()
+  {
+    return boost::mpl::at_c<types, I>::type::tag_type::name();
+  }
+
+  template <std::size_t... I>
+  static constexpr bool unique_hashes(std::index_sequence<I...>)
+  {
+    const std::uint64_t hashes[N] = {rc_name_hash(level_name<I>())...};
+    return rc_perfect_hash<N>::unique(hashes);
+  }
+
+  template <std::size_t... I>
+  static constexpr rc_perfect_hash<N> make_table(std::index_sequence<I...>)
+  {
+    static_assert(unique_hashes(std::index_sequence<I...>()), "duplicate level name");
+    const std::uint64_t hashes[N] = {rc_name_hash(level_name<I>())...};
+    return rc_perfect_hash<N>(hashes);
+  }
+  static constexpr rc_perfect_hash<0> make_table(std::index_sequence<>) { return rc_perfect_hash<0>(); }
+
+  template <std::size_t... I>
+  static const char* const* names(std::index_sequence<I...>)
+  {
+    static const char* const values[N] = {level_name<I>()...};
+    return values;
+  }
+
+  static constexpr rc_perfect_hash<N> sTable = make_table(std::make_index_sequence<N>());
+};
+
+template <typename ContainerT>
+constexpr rc_perfect_hash<rc_name_index<ContainerT>::N> rc_name_index<ContainerT>::sTable;
+
+}; // namespace gNeric
+
+#endif
@@ -0,0 +1,322 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_PIPELINE_H
+#define RC_PIPELINE_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_pipeline.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Pipelined processing of container streams in functor stages
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// A pipeline chains stages over a stream of containers. The stream is cut
+// into batches of batchSize containers, a batch passes all stages before it
+// is reused, which keeps the data of a batch in the cache. Each stage runs
+// in its own thread, the stages are connected by bounded lock-free single
+// producer single consumer queues. The batches are allocated once and go
+// back to the source after the last stage, recycled containers are reset,
+// see the container's reset function.
+//
+// Usage:
+//   Pipeline<container_type> pipeline(64);
+//   pipeline.add_container_stage("fill", [](container_type& c, std::size_t index) { ... });
+//   pipeline.add_stage("transform", scale_levels(2.));  // level functor, applied with for_each
+//   pipeline.add_stage("reduce", sum_levels(sums));
+//   pipeline.run(ncontainers);
+//   pipeline.print_stats(std::cout);
+//
+// run_inline processes the batches through all stages on the calling thread.
+// Every stage keeps counters of the processed containers and batches, and of
+// the time spent in the stage and waiting for input. The functor of a stage
+// is only called from the thread of the stage, it can keep a state without
+// synchronization.
+
+#include "runtime_container.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gNeric
+{
+/**
+ * @class rc_spsc_queue
+ * @brief Bounded lock-free queue for one producer and one consumer thread
+ *
+ * The capacity is rounded up to a power of two. The positions of producer
+ * and consumer are on separate cache lines. They are padded instead of
+ * aligned, the queue is allocated with new, which does not support
+ * over-aligned types before C++17.
+ */
+template <typename T>
+class rc_spsc_queue
+{
+ public:
+  explicit rc_spsc_queue(std::size_t capacity) : mMask(round_up(capacity) - 1), mSlots(mMask + 1), mHead(0), mTail(0)
+  {
+  }
+
+  /// called by the producer, returns false if the queue is full
+  bool try_push(const T& value)
+  {
+    const std::size_t tail = mTail.load(std::memory_order_relaxed);
+    if (tail - mHead.load(std::memory_order_acquire) > mMask) return false;
+    mSlots[tail & mMask] = value;
+    mTail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+  /// called by the consumer, returns false if the queue is empty
+  bool try_pop(T& value)
+  {
+    const std::size_t head = mHead.load(std::memory_order_relaxed);
+    if (head == mTail.load(std::memory_order_acquire)) return false;
+    value = mSlots[head & mMask];
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+  }
+  std::size_t capacity() const { return mMask + 1; }
+
+ private:
+  rc_spsc_queue(const rc_spsc_queue&); // forbidden
+  rc_spsc_queue& operator=(const rc_spsc_queue&); // forbidden
+
+  static std::size_t round_up(std::size_t n)
+  {
+    std::size_t capacity = 1;
+    while (capacity < n) capacity <<= 1;
+    return capacity;
+  }
+
+  static const std::size_t cacheLine = 64;
+  typedef std::atomic<std::size_t> position;
+
+  const std::size_t mMask;
+  std::vector<T> mSlots;
+  char mHeadPadding[cacheLine];
+  position mHead;
+  char mTailPadding[cacheLine - sizeof(position)];
+  position mTail;
+  char mEndPadding[cacheLine - sizeof(position)];
+};
+
+/**
+ * @brief Counters of a pipeline stage
+ */
+struct rc_stage_stats {
+  std::string name;
+  std::size_t containers; // processed containers
+  std::size_t batches;    // processed batches
+  double busyTime;        // time in the stage functor in s
+  double waitTime;        // time waiting for input or output in s
+
+  /// containers per second of busy time
+  double throughput() const { return busyTime > 0. ? containers / busyTime : 0.; }
+};
+
+/**
+ * @class Pipeline
+ * @brief Chain of stages over a stream of runtime containers
+ *
+ * @tparam ContainerT  container type created by create_rtc
+ */
+template <typename ContainerT>
+class Pipeline
+{
+ public:
+  typedef ContainerT container_type;
+
+  /// a batch of the stream, first is the stream index of the first container
+  struct batch {
+    std::vector<ContainerT> containers;
+    std::size_t first;
+    std::size_t size;
+  };
+
+  Pipeline(std::size_t batchSize = 64, std::size_t queueDepth = 4)
+    : mBatchSize(batchSize > 0 ? batchSize : 1), mQueueDepth(queueDepth > 0 ? queueDepth : 1)
+  {
+  }
+
+  /// add a stage calling f(container, stream index) for every container
+  template <typename F>
+  void add_container_stage(const std::string& name, F f)
+  {
+    add(name, [f](batch& b) mutable {
+      for (std::size_t i = 0; i < b.size; i++) f(b.containers[i], b.first + i);
+    });
+  }
+
+  /// add a stage applying the level functor f to all levels of every container,
+  /// one copy of f is used for all containers of the stream
+  template <typename F>
+  void add_stage(const std::string& name, F f)
+  {
+    add(name, [f](batch& b) mutable {
+      for (std::size_t i = 0; i < b.size; i++) b.containers[i].for_each(rc_functor_ref<F>(f));
+    });
+  }
+
+  /// process ncontainers with one thread per stage, returns when the stream is done
+  void run(std::size_t ncontainers)
+  {
+    const std::size_t nStages = mStages.size();
+    if (nStages == 0) return;
+    // queue i feeds stage i, queue nStages returns the batches to the source
+    // and can hold all batches
+    std::vector<std::unique_ptr<rc_spsc_queue<batch*>>> queues;
+    for (std::size_t i = 0; i < nStages; i++) queues.emplace_back(new rc_spsc_queue<batch*>(mQueueDepth));
+    std::vector<batch> batches(queues[0]->capacity() * (nStages + 1));
+    queues.emplace_back(new rc_spsc_queue<batch*>(batches.size()));
+    rc_spsc_queue<batch*>& source = *queues[0];
+    rc_spsc_queue<batch*>& recycled = *queues[nStages];
+    std::size_t nAllocated = 0;
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < nStages; i++) {
+      threads.emplace_back(
+        [this, i, nStages, &queues]() { run_stage(mStages[i], *queues[i], *queues[i + 1], i + 1 == nStages); });
+    }
+    std::size_t first = 0;
+    while (first < ncontainers) {
+      // prefer the recycled batches, their data is still in the cache
+      batch* b = nullptr;
+      if (recycled.try_pop(b) || nAllocated == batches.size()) {
+        while (b == nullptr && !recycled.try_pop(b)) std::this_thread::yield();
+        for (auto& container : b->containers) container.reset();
+      } else {
+        b = &batches[nAllocated++];
+        b->containers.resize(mBatchSize);
+      }
+      b->first = first;
+      b->size = std::min(mBatchSize, ncontainers - first);
+      first += b->size;
+      push(source, b);
+    }
+    push(source, nullptr);
+    for (auto& thread : threads) thread.join();
+  }
+
+  /// process ncontainers on the calling thread, every batch passes all stages
+  void run_inline(std::size_t ncontainers)
+  {
+    batch b;
+    b.containers.resize(mBatchSize);
+    for (std::size_t first = 0; first < ncontainers; first += b.size) {
+      if (first > 0) {
+        for (auto& container : b.containers) container.reset();
+      }
+      b.first = first;
+      b.size = std::min(mBatchSize, ncontainers - first);
+      for (auto& stage : mStages) process(stage, b);
+    }
+  }
+
+  /// counters of all stages
+  std::vector<rc_stage_stats> stats() const
+  {
+    std::vector<rc_stage_stats> result;
+    for (auto& stage : mStages) result.push_back(stage.stats);
+    return result;
+  }
+  void reset_stats()
+  {
+    for (auto& stage : mStages) stage.stats = make_stats(stage.stats.name);
+  }
+  void print_stats(std::ostream& out) const
+  {
+    out << std::setw(16) << "stage" << " " << std::setw(12) << "containers" << " " << std::setw(10) << "batches" << " "
+        << std::setw(10) << "busy/ms" << " " << std::setw(10) << "wait/ms" << " " << std::setw(14) << "containers/s"
+        << std::endl;
+    for (auto& stage : mStages) {
+      const rc_stage_stats& s = stage.stats;
+      out << std::setw(16) << s.name << " " << std::setw(12) << s.containers << " " << std::setw(10) << s.batches << " "
+          << std::setw(10) << std::fixed << std::setprecision(1) << 1e3 * s.busyTime << " " << std::setw(10)
+          << 1e3 * s.waitTime << " " << std::setw(14) << std::scientific << std::setprecision(3) << s.throughput()
+          << std::defaultfloat << std::endl;
+    }
+  }
+
+ private:
+  typedef std::chrono::steady_clock steady_clock;
+
+  struct stage {
+    std::function<void(batch&)> process;
+    rc_stage_stats stats;
+  };
+
+  static rc_stage_stats make_stats(const std::string& name)
+  {
+    rc_stage_stats stats = {name, 0, 0, 0., 0.};
+    return stats;
+  }
+
+  void add(const std::string& name, std::function<void(batch&)> f)
+  {
+    stage s = {f, make_stats(name)};
+    mStages.push_back(s);
+  }
+
+  static double seconds(steady_clock::time_point begin, steady_clock::time_point end)
+  {
+    return std::chrono::duration<double>(end - begin).count();
+  }
+
+  static void process(stage& s, batch& b)
+  {
+    steady_clock::time_point begin = steady_clock::now();
+    s.process(b);
+    s.stats.busyTime += seconds(begin, steady_clock::now());
+    s.stats.containers += b.size;
+    s.stats.batches++;
+  }
+
+  static void push(rc_spsc_queue<batch*>& queue, batch* b)
+  {
+    while (!queue.try_push(b)) std::this_thread::yield();
+  }
+
+  /// stage thread, a null batch terminates the stream
+  static void run_stage(stage& s, rc_spsc_queue<batch*>& input, rc_spsc_queue<batch*>& output, bool last)
+  {
+    while (true) {
+      batch* b = nullptr;
+      steady_clock::time_point begin = steady_clock::now();
+      while (!input.try_pop(b)) std::this_thread::yield();
+      s.stats.waitTime += seconds(begin, steady_clock::now());
+      if (b == nullptr) break;
+      process(s, *b);
+      begin = steady_clock::now();
+      push(output, b);
+      s.stats.waitTime += seconds(begin, steady_clock::now());
+    }
+    // the last stage returns the batches to the source, which does not
+    // wait for the terminating null batch
+    if (!last) push(output, nullptr);
+  }
+
+  std::size_t mBatchSize;
+  std::size_t mQueueDepth;
+  std::vector<stage> mStages;
+};
+
+}; // namespace gNeric
+
+#endif
@@ -0,0 +1,180 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_POOL_H
+#define RC_POOL_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_pool.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Object pool recycling runtime containers
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// The pool hands out constructed containers and takes them back when the
+// handle goes out of scope. A returned container is not destroyed but reset
+// with the container's reset function, which applies the initializer policy
+// to every level. Members like std::vector keep their allocated memory, a
+// recycled container needs neither construction nor heap allocations.
+//
+// Usage:
+//   ContainerPool<container_type> pool(64);
+//   for (auto& event : events) {
+//     auto container = pool.acquire();
+//     container->apply(index, add_value<int>(1));
+//   } // the container is reset and returned to the pool
+//
+// The free containers are kept in one list per thread slot, see
+// rc_thread_slot in rc_atomic.h. A thread returns containers to its own list
+// and takes from it first, the lists of the other threads are only searched
+// when the own list is empty. All handles have to be released before the
+// pool is destroyed. The reset of a returned container should not throw: the
+// container is then deleted and the exception is passed on, which terminates
+// the program if the handle is released by its destructor.
+
+#include "rc_atomic.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace gNeric
+{
+/**
+ * @class ContainerPool
+ * @brief Pool of runtime containers with per-thread free lists
+ *
+ * @tparam ContainerT  container type created by create_rtc
+ * @tparam NLists      number of free lists, threads share lists beyond
+ */
+template <typename ContainerT, std::size_t NLists = 16>
+class ContainerPool
+{
+ public:
+  typedef ContainerT container_type;
+
+  /// returns the container to the pool when the handle is destroyed
+  class releaser
+  {
+   public:
+    releaser() : mPool(nullptr) {}
+    explicit releaser(ContainerPool* pool) : mPool(pool) {}
+    void operator()(ContainerT* container) const { mPool->release(container); }
+
+   private:
+    ContainerPool* mPool;
+  };
+  typedef std::unique_ptr<ContainerT, releaser> handle;
+
+  /// create the pool with a number of containers distributed over the lists
+  explicit ContainerPool(std::size_t preallocate = 0) : mConstructed(preallocate)
+  {
+    for (std::size_t i = 0; i < preallocate; i++) {
+      mLists[i % NLists].containers.push_back(new ContainerT);
+    }
+  }
+  ~ContainerPool()
+  {
+    for (auto& list : mLists) {
+      for (auto container : list.containers) delete container;
+    }
+  }
+
+  /// get a container, a new one is constructed if all lists are empty
+  handle acquire()
+  {
+    const std::size_t slot = rc_thread_slot();
+    for (std::size_t i = 0; i < NLists; i++) {
+      ContainerT* container = mLists[(slot + i) % NLists].pop();
+      if (container) return handle(container, releaser(this));
+    }
+    mConstructed.fetch_add(1, std::memory_order_relaxed);
+    return handle(new ContainerT, releaser(this));
+  }
+
+  /// number of containers constructed by the pool
+  std::size_t constructed() const { return mConstructed.load(std::memory_order_relaxed); }
+  /// number of containers in the free lists
+  std::size_t available() const
+  {
+    std::size_t n = 0;
+    for (auto& list : mLists) n += list.size();
+    return n;
+  }
+
+ private:
+  ContainerPool(const ContainerPool&); // forbidden
+  ContainerPool& operator=(const ContainerPool&); // forbidden
+
+  /// reset the container and put it into the list of the thread, a container
+  /// whose reset throws is deleted before the exception is passed on
+  void release(ContainerT* container)
+  {
+    try {
+      container->reset();
+    } catch (...) {
+      delete container;
+      throw;
+    }
+    mLists[rc_thread_slot() % NLists].push(container);
+  }
+
+  class lock_guard
+  {
+   public:
+    lock_guard(std::atomic_flag& lock) : mLock(lock)
+    {
+      while (mLock.test_and_set(std::memory_order_acquire)) {
+      }
+    }
+    ~lock_guard() { mLock.clear(std::memory_order_release); }
+
+   private:
+    std::atomic_flag& mLock;
+  };
+
+  // the lists are padded to separate cache lines instead of aligned, the pool
+  // may be allocated with new, which does not support over-aligned types
+  // before C++17
+  struct free_list {
+    free_list() { lock.clear(); }
+    ContainerT* pop()
+    {
+      lock_guard guard(lock);
+      if (containers.empty()) return nullptr;
+      ContainerT* container = containers.back();
+      containers.pop_back();
+      return container;
+    }
+    void push(ContainerT* container)
+    {
+      lock_guard guard(lock);
+      containers.push_back(container);
+    }
+    std::size_t size() const
+    {
+      lock_guard guard(lock);
+      return containers.size();
+    }
+
+    mutable std::atomic_flag lock;
+    std::vector<ContainerT*> containers;
+    char padding[64];
+  };
+
+  free_list mLists[NLists];
+  std::atomic<std::size_t> mConstructed;
+};
+
+}; // namespace gNeric
+
+#endif
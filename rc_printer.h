@@ -0,0 +1,317 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_PRINTER_H
+#define RC_PRINTER_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_printer.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Buffered printer policies for the runtime container
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// Printer policies which produce the same output as the verbose_printer, but
+// format all levels of a container into a buffer and write the buffer with
+// one call when the base level is reached:
+// - buffered_printer  writes the buffer to std::cout and flushes once
+// - async_printer     hands the buffer to a background writer thread
+//
+// The buffers are reused, after the first print of a container there are no
+// allocations. Numbers are formatted with std::to_chars, other types can be
+// supported by an overload of rc_format(std::string&, const T&).
+//
+// Usage: typedef RuntimeContainer<DefaultInterface, default_initializer, buffered_printer> base;
+//
+// Requires C++17.
+
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gNeric
+{
+/// character types are printed as characters like by the stream operator
+template <typename T>
+struct rc_is_char
+  : std::integral_constant<bool, std::is_same<T, char>::value || std::is_same<T, signed char>::value ||
+                                   std::is_same<T, unsigned char>::value> {
+};
+
+/// append an integral number to the buffer
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && !rc_is_char<T>::value && !std::is_same<T, bool>::value>::type
+rc_format(std::string& buffer, const T& v)
+{
+  char digits[24];
+  auto result = std::to_chars(digits, digits + sizeof(digits), v);
+  buffer.append(digits, result.ptr);
+}
+/// append a floating point number, precision 6 like the default of the streams
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type rc_format(std::string& buffer, const T& v)
+{
+  char digits[64];
+  auto result = std::to_chars(digits, digits + sizeof(digits), v, std::chars_format::general, 6);
+  buffer.append(digits, result.ptr);
+}
+template <typename T>
+typename std::enable_if<rc_is_char<T>::value>::type rc_format(std::string& buffer, const T& v)
+{
+  buffer.push_back(static_cast<char>(v));
+}
+inline void rc_format(std::string& buffer, bool v) { buffer.push_back(v ? '1' : '0'); }
+inline void rc_format(std::string& buffer, const char* v) { buffer.append(v); }
+inline void rc_format(std::string& buffer, const std::string& v) { buffer.append(v); }
+
+/// fallback for all other types using the stream operator, this allocates
+template <typename T>
+typename std::enable_if<!std::is_arithmetic<T>::value && !std::is_convertible<T, const char*>::value &&
+                        !std::is_same<T, std::string>::value>::type
+rc_format(std::string& buffer, const T& v)
+{
+  std::ostringstream stream;
+  stream << v;
+  buffer.append(stream.str());
+}
+
+/// append the line of one level in the format of verbose_printer
+template <typename T>
+void rc_format_level(std::string& buffer, const T& v, int level)
+{
+  buffer.append("RC mixin level ");
+  if (level >= 0 && level < 10) buffer.push_back(' ');
+  rc_format(buffer, level);
+  buffer.append(": ");
+  rc_format(buffer, v);
+  buffer.push_back('\n');
+}
+
+/**
+ * @brief Printer policy writing all levels of a container at once
+ * The levels are collected in a thread local buffer, the buffer is written
+ * to std::cout and flushed at the base level.
+ */
+struct buffered_printer {
+  template <typename T>
+  bool operator()(const T& v, int level = -1)
+  {
+    std::string& buffer = local_buffer();
+    rc_format_level(buffer, v, level);
+    if (level < 0) {
+      std::cout.write(buffer.data(), buffer.size());
+      std::cout.flush();
+      buffer.clear();
+    }
+    return true;
+  }
+
+ private:
+  static std::string& local_buffer()
+  {
+    thread_local std::string buffer;
+    return buffer;
+  }
+};
+
+/**
+ * @class rc_async_writer
+ * @brief Background thread writing buffers to std::cout
+ *
+ * Buffers are taken from a pool of recycled buffers with acquire, filled and
+ * handed to the writer thread with try_submit. After writing, the buffer goes
+ * back to the pool. The thread is started with the first use and joined at
+ * program exit after all pending buffers have been written.
+ *
+ * The queue holds at most maxQueued buffers, try_submit does not wait and
+ * leaves the buffer with the caller if the queue is full. The pool keeps at
+ * most maxPooled buffers, further buffers are released.
+ */
+class rc_async_writer
+{
+ public:
+  static const std::size_t maxQueued = 64;
+  static const std::size_t maxPooled = 64;
+
+  static rc_async_writer& instance()
+  {
+    static rc_async_writer writer;
+    return writer;
+  }
+
+  /// get an empty buffer from the pool
+  std::unique_ptr<std::string> acquire()
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mPool.empty()) {
+      return std::unique_ptr<std::string>(new std::string);
+    }
+    std::unique_ptr<std::string> buffer = std::move(mPool.back());
+    mPool.pop_back();
+    return buffer;
+  }
+
+  /// queue a buffer for writing, returns false and keeps the buffer if the queue is full
+  bool try_submit(std::unique_ptr<std::string>& buffer)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (mQueue.size() >= maxQueued) return false;
+      mQueue.push_back(std::move(buffer));
+    }
+    mCondition.notify_one();
+    return true;
+  }
+
+  /// queue a buffer for writing, waits while the queue is full
+  void submit(std::unique_ptr<std::string> buffer)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mSpace.wait(lock, [this]() { return mQueue.size() < maxQueued; });
+      mQueue.push_back(std::move(buffer));
+    }
+    mCondition.notify_one();
+  }
+
+  /// wait until all queued buffers have been written
+  void drain()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDrained.wait(lock, [this]() { return mQueue.empty() && !mWriting; });
+  }
+
+  ~rc_async_writer()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mCondition.notify_one();
+    mThread.join();
+  }
+
+ private:
+  rc_async_writer() : mStop(false), mWriting(false), mThread(&rc_async_writer::run, this) {}
+  rc_async_writer(const rc_async_writer&); // forbidden
+  rc_async_writer& operator=(const rc_async_writer&); // forbidden
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+      mCondition.wait(lock, [this]() { return mStop || !mQueue.empty(); });
+      if (mQueue.empty()) break;
+      std::unique_ptr<std::string> buffer = std::move(mQueue.front());
+      mQueue.pop_front();
+      mWriting = true;
+      lock.unlock();
+      mSpace.notify_one();
+      std::cout.write(buffer->data(), buffer->size());
+      std::cout.flush();
+      buffer->clear();
+      lock.lock();
+      mWriting = false;
+      if (mPool.size() < maxPooled) mPool.push_back(std::move(buffer));
+      if (mQueue.empty()) mDrained.notify_all();
+    }
+  }
+
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::condition_variable mDrained;
+  std::condition_variable mSpace;
+  std::deque<std::unique_ptr<std::string>> mQueue;
+  std::vector<std::unique_ptr<std::string>> mPool;
+  bool mStop;
+  bool mWriting;
+  std::thread mThread;
+};
+
+/**
+ * @brief Printer policy handing the output to a background writer
+ * The levels are formatted into a buffer from the pool of rc_async_writer,
+ * the buffer is submitted to the writer at the base level. The processing
+ * thread never waits for the output: if the queue of the writer is full, the
+ * buffer stays with the thread and the next containers are appended to it.
+ * If the kept buffer exceeds maxDeferred bytes, the output of the container
+ * is dropped and counted, see dropped(). The buffer of a thread is submitted
+ * by drain and at the end of the thread.
+ */
+struct async_printer {
+  static const std::size_t maxDeferred = std::size_t(1) << 20;
+
+  template <typename T>
+  bool operator()(const T& v, int level = -1)
+  {
+    local_state& local = state();
+    if (!local.buffer) local.buffer = rc_async_writer::instance().acquire();
+    rc_format_level(*local.buffer, v, level);
+    if (level < 0) {
+      if (rc_async_writer::instance().try_submit(local.buffer)) {
+        local.kept = 0;
+      } else if (local.buffer->size() > maxDeferred) {
+        local.buffer->resize(local.kept);
+        drops()++;
+      } else {
+        local.kept = local.buffer->size();
+      }
+    }
+    return true;
+  }
+
+  /// wait until all output of the calling thread has been written
+  static void drain()
+  {
+    local_state& local = state();
+    if (local.buffer && !local.buffer->empty()) rc_async_writer::instance().submit(std::move(local.buffer));
+    local.kept = 0;
+    rc_async_writer::instance().drain();
+  }
+
+  /// number of container dumps dropped because the output was too slow
+  static std::size_t dropped() { return drops(); }
+
+ private:
+  /// the buffer of a thread, kept is the size of the complete dumps in it
+  struct local_state {
+    std::unique_ptr<std::string> buffer;
+    std::size_t kept = 0;
+    ~local_state()
+    {
+      if (buffer && !buffer->empty()) rc_async_writer::instance().submit(std::move(buffer));
+    }
+  };
+  static local_state& state()
+  {
+    thread_local local_state local;
+    return local;
+  }
+  static std::atomic<std::size_t>& drops()
+  {
+    static std::atomic<std::size_t> count(0);
+    return count;
+  }
+};
+
+}; // namespace gNeric
+
+#endif
@@ -0,0 +1,192 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_REFLECTION_H
+#define RC_REFLECTION_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_reflection.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Metadata table of the levels of a runtime container
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// The metadata table describes every level of a container type by index,
+// type name, tag name, size, alignment and offset of the member within the
+// container. Tools like serializers or memory accounting can walk the table
+// with a plain loop instead of instantiating recursive templates:
+//
+//   typedef rc_reflection<container_type> reflection;
+//   for (auto& level : reflection::levels()) {
+//     const void* member = reflection::address(container, level.index);
+//     ...
+//   }
+//
+// Index, tag name, size and alignment of a level are known at compile time,
+// see static_level<I>(). The table is built once per container type at the
+// first call of levels(). The member offsets can not be computed at compile
+// time because the members are in base classes of the container, one
+// container is default constructed to determine the offsets: the container
+// type has to be default constructible, the initializer policy runs for all
+// levels and the lazy levels of this one container are engaged.
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <typeinfo>
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/size.hpp>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+namespace gNeric
+{
+/**
+ * @brief Metadata of one container level
+ */
+struct rc_level_info {
+  int index;             // level index
+  const char* type_name; // name of the member type
+  const char* tag_name;  // name of the tag, nullptr if the tag has no name
+  std::size_t size;      // sizeof of the member type
+  std::size_t align;     // alignof of the member type
+  std::size_t offset;    // offset of the member from the container address
+};
+
+/**
+ * @brief Name of a type
+ * Demangled type name from typeid, can be specialized for custom names.
+ */
+template <typename T>
+struct rc_type_name {
+  static std::string get()
+  {
+    const char* mangled = typeid(T).name();
+#ifdef __GNUG__
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (status == 0 && demangled) {
+      std::string name(demangled);
+      std::free(demangled);
+      return name;
+    }
+#endif
+    return mangled;
+  }
+};
+
+/**
+ * @brief Name of a tag, nullptr if the tag has no static name() function
+ */
+template <typename Tag>
+struct rc_tag_name {
+  static constexpr const char* get() { return name<Tag>(0); }
+
+ private:
+  template <typename U>
+  static constexpr auto name(int) -> decltype(U::name())
+  {
+    return U::name();
+  }
+  template <typename U>
+  static constexpr const char* name(...)
+  {
+    return nullptr;
+  }
+};
+
+/**
+ * @class rc_reflection
+ * @brief Metadata table of a runtime container type
+ */
+template <typename ContainerT>
+class rc_reflection
+{
+ public:
+  typedef typename ContainerT::types types;
+  static const std::size_t N = boost::mpl::size<types>::value;
+  typedef std::array<rc_level_info, N> table_type;
+
+  /// the table of all levels
+  static const table_type& levels()
+  {
+    static const table_type table = make_table();
+    return table;
+  }
+  /// the metadata of level index
+  static const rc_level_info& level(int index) { return levels()[index]; }
+
+  /// the metadata of level I known at compile time, without type name and offset
+  template <std::size_t I>
+  static constexpr rc_level_info static_level()
+  {
+    typedef typename boost::mpl::at_c<types, I>::type stage;
+    typedef typename stage::wrapped_type wrapped_type;
+    return rc_level_info{int(I), nullptr, rc_tag_name<typename stage::tag_type>::get(), sizeof(wrapped_type),
+                         alignof(wrapped_type), 0};
+  }
+
+  /// address of the member of level index
+  static void* address(ContainerT& container, int index)
+  {
+    return reinterpret_cast<char*>(&container) + levels()[index].offset;
+  }
+  static const void* address(const ContainerT& container, int index)
+  {
+    return reinterpret_cast<const char*>(&container) + levels()[index].offset;
+  }
+
+ private:
+  /// fill the table entry of a level, type name and offset at runtime
+  class fill_level
+  {
+   public:
+    typedef void return_type;
+    fill_level(table_type& table, std::array<std::string, N>& typeNames, const ContainerT& container)
+      : mTable(table), mTypeNames(typeNames), mContainer(container)
+    {
+    }
+    template <typename T>
+    return_type operator()(T& stage)
+    {
+      typedef typename T::wrapped_type wrapped_type;
+      const int index = T::level::value;
+      mTypeNames[index] = rc_type_name<wrapped_type>::get();
+      const char* member = reinterpret_cast<const char*>(&*static_cast<const T&>(stage));
+      rc_level_info& info = mTable[index];
+      info = static_level<T::level::value>();
+      info.type_name = mTypeNames[index].c_str();
+      info.offset = member - reinterpret_cast<const char*>(&mContainer);
+    }
+
+   private:
+    table_type& mTable;
+    std::array<std::string, N>& mTypeNames;
+    const ContainerT& mContainer;
+  };
+
+  static table_type make_table()
+  {
+    // the type names are kept for the lifetime of the program
+    static std::array<std::string, N> typeNames;
+    table_type table;
+    ContainerT container;
+    container.for_each(fill_level(table, typeNames, container));
+    return table;
+  }
+};
+
+}; // namespace gNeric
+
+#endif
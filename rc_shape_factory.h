@@ -0,0 +1,279 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_SHAPE_FACTORY_H
+#define RC_SHAPE_FACTORY_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_shape_factory.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Runtime selection of the levels of a container from a master type list
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// The shape of a container is the subset of a master type list, selected by
+// a runtime bitmask with bit i for type i. The factory creates a batch of
+// containers of the selected shape. The container type is built by create_rtc
+// from the selected types only, levels which are not selected do not exist.
+//
+// The batch is returned as a type-erased handle. The operations on the batch
+// are visitors, which are called once per batch with the vector of the
+// concrete containers, the loop over the containers inside the visitor is
+// compiled for the concrete type. The visitor types are fixed at compile
+// time, rc_for_each_visitor applies a level functor to all levels of all
+// containers.
+//
+// Usage:
+//   typedef boost::mpl::vector<tagged<energy_tag, float>, tagged<charge_tag, int>, ...> master_types;
+//   typedef rc_for_each_visitor<fill_levels> fill;
+//   typedef rc_shape_factory<master_types, RuntimeContainer<>, fill> factory;
+//   factory::handle batch = factory::create(job.shape);  // e.g. 0x5: energy and the third type
+//   batch->resize(n);
+//   fill f(fill_levels(...));
+//   batch->accept(f);
+//
+// create instantiates the containers for all 2^N subsets of the N master
+// types, which is feasible for a few types, at most 10. Up to 64 types are
+// supported by create_selected<Shapes>, which only instantiates the masks in
+// the MPL sequence Shapes and returns nullptr for other masks. The selection is done with the CompositeCreator of
+// composite_factory.h and a creator policy making the batch.
+
+#include "runtime_container.h"
+#include "composite_factory.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/eval_if.hpp>
+#include <boost/mpl/identity.hpp>
+#include <boost/mpl/integral_c.hpp>
+#include <boost/mpl/next.hpp>
+#include <boost/mpl/pair.hpp>
+#include <boost/mpl/push_back.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/mpl/vector.hpp>
+
+namespace gNeric
+{
+/// tag of the terminating accept function of rc_batch
+class rc_batch_end;
+
+/**
+ * @class rc_batch
+ * @brief Type-erased handle of a batch of containers of one shape
+ *
+ * One accept function per visitor type, the visitor is called with the
+ * vector of containers and the shape.
+ */
+template <typename... Visitors>
+class rc_batch;
+
+template <>
+class rc_batch<>
+{
+ public:
+  virtual ~rc_batch() {}
+  /// number of containers
+  virtual std::size_t size() const = 0;
+  virtual void resize(std::size_t n) = 0;
+  /// bitmask of the selected master types
+  virtual std::uint64_t shape() const = 0;
+  /// number of levels of the containers
+  virtual std::size_t levels() const = 0;
+
+ protected:
+  void accept(rc_batch_end&);
+};
+
+template <typename V, typename... Rest>
+class rc_batch<V, Rest...> : public rc_batch<Rest...>
+{
+ public:
+  using rc_batch<Rest...>::accept;
+  virtual void accept(V& visitor) = 0;
+};
+
+/**
+ * @class rc_batch_impl
+ * @brief Batch of containers of type ContainerT
+ */
+template <typename ContainerT, typename Interface, typename... Visitors>
+class rc_batch_impl;
+
+template <typename ContainerT, typename Interface>
+class rc_batch_impl<ContainerT, Interface> : public Interface
+{
+ public:
+  typedef ContainerT container_type;
+  explicit rc_batch_impl(std::uint64_t shape) : mContainers(), mShape(shape) {}
+
+  std::size_t size() const override { return mContainers.size(); }
+  void resize(std::size_t n) override { mContainers.resize(n); }
+  std::uint64_t shape() const override { return mShape; }
+  std::size_t levels() const override { return boost::mpl::size<typename ContainerT::types>::value; }
+
+ protected:
+  std::vector<ContainerT> mContainers;
+  std::uint64_t mShape;
+};
+
+template <typename ContainerT, typename Interface, typename V, typename... Rest>
+class rc_batch_impl<ContainerT, Interface, V, Rest...> : public rc_batch_impl<ContainerT, Interface, Rest...>
+{
+ public:
+  explicit rc_batch_impl(std::uint64_t shape) : rc_batch_impl<ContainerT, Interface, Rest...>(shape) {}
+  void accept(V& visitor) override { visitor(this->mContainers, this->mShape); }
+};
+
+/**
+ * @brief Visitor applying a level functor to all levels of all containers
+ */
+template <typename F>
+class rc_for_each_visitor
+{
+ public:
+  rc_for_each_visitor(F f = F()) : mFunctor(f) {}
+  template <typename ContainerT>
+  void operator()(std::vector<ContainerT>& containers, std::uint64_t /*shape*/)
+  {
+    for (auto& container : containers) container.for_each(mFunctor);
+  }
+  F& functor() { return mFunctor; }
+
+ private:
+  F mFunctor;
+};
+
+/**
+ * @brief Pairs of flag (1 << position) and type for all types of a list
+ */
+template <typename _Iterator, typename _End, int Position, typename Result>
+struct rc_shape_flags {
+  typedef typename rc_shape_flags<
+    typename boost::mpl::next<_Iterator>::type, _End, Position + 1,
+    typename boost::mpl::push_back<Result, boost::mpl::pair<boost::mpl::integral_c<std::uint64_t, std::uint64_t(1)
+                                                                                                    << Position>,
+                                                            typename boost::mpl::deref<_Iterator>::type>>::type>::type
+    type;
+};
+template <typename _End, int Position, typename Result>
+struct rc_shape_flags<_End, _End, Position, Result> {
+  typedef Result type;
+};
+
+/**
+ * @brief The types of a list selected by a mask
+ */
+template <typename _Iterator, typename _End, std::uint64_t Mask, typename Result>
+struct rc_shape_types {
+  typedef typename rc_shape_types<
+    typename boost::mpl::next<_Iterator>::type, _End, (Mask >> 1),
+    typename boost::mpl::eval_if_c<(Mask & 1) != 0,
+                                   boost::mpl::push_back<Result, typename boost::mpl::deref<_Iterator>::type>,
+                                   boost::mpl::identity<Result>>::type>::type type;
+};
+template <typename _End, std::uint64_t Mask, typename Result>
+struct rc_shape_types<_End, _End, Mask, Result> {
+  typedef Result type;
+};
+
+/**
+ * @brief Creator policy for CompositeCreator: batch of containers of the selected types
+ */
+template <typename Base, typename Interface, typename... Visitors>
+struct rc_batch_creator {
+  typedef std::unique_ptr<Interface> return_type;
+
+  template <typename Types, typename Property>
+  static return_type create(Property shape)
+  {
+    typedef typename create_rtc<Types, Base>::type container_type;
+    return return_type(new rc_batch_impl<container_type, Interface, Visitors...>(shape));
+  }
+};
+
+/**
+ * @class rc_shape_factory
+ * @brief Batches of containers with a runtime selection of the master types
+ *
+ * @tparam Types     master type list, at most 10 types for create, 64 for create_selected
+ * @tparam Base      base of the containers, see RuntimeContainer
+ * @tparam Visitors  operations on the batches
+ */
+template <typename Types, typename Base = RuntimeContainer<>, typename... Visitors>
+class rc_shape_factory
+{
+ public:
+  typedef Types types;
+  typedef rc_batch<Visitors...> batch_type;
+  typedef std::unique_ptr<batch_type> handle;
+  static const std::size_t nTypes = boost::mpl::size<Types>::value;
+  /// maximum number of master types for create, which instantiates 2^N containers
+  static const std::size_t maxCreateTypes = 10;
+  static_assert(nTypes <= 64, "the shape mask supports at most 64 types");
+
+  /// container type of a shape known at compile time
+  template <std::uint64_t Shape>
+  struct container {
+    typedef typename create_rtc<typename rc_shape_types<typename boost::mpl::begin<Types>::type,
+                                                        typename boost::mpl::end<Types>::type, Shape,
+                                                        boost::mpl::vector<>>::type,
+                                Base>::type type;
+  };
+
+  /// mask with the bits of all master types
+  static constexpr std::uint64_t full_shape()
+  {
+    return nTypes == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << nTypes) - 1;
+  }
+
+  /// batch of the shape, all subsets are instantiated, bits beyond the types are ignored
+  static handle create(std::uint64_t shape)
+  {
+    static_assert(nTypes <= maxCreateTypes, "create supports at most 10 master types, use create_selected");
+    typedef typename rc_shape_flags<typename boost::mpl::begin<Types>::type, typename boost::mpl::end<Types>::type, 0,
+                                    boost::mpl::vector<>>::type flags;
+    return CompositeCreator<batch_type, Base, std::uint64_t, flags,
+                            rc_batch_creator<Base, batch_type, Visitors...>>::apply(shape & full_shape());
+  }
+
+  /// batch of the shape if it is in the MPL sequence of masks Shapes, nullptr otherwise
+  template <typename Shapes>
+  static handle create_selected(std::uint64_t shape)
+  {
+    return select<typename boost::mpl::begin<Shapes>::type, typename boost::mpl::end<Shapes>::type>::apply(
+      shape & full_shape());
+  }
+
+ private:
+  template <typename _Iterator, typename _End>
+  struct select {
+    static handle apply(std::uint64_t shape)
+    {
+      const std::uint64_t mask = boost::mpl::deref<_Iterator>::type::value & full_shape();
+      if (shape == mask) {
+        typedef typename container<boost::mpl::deref<_Iterator>::type::value & full_shape()>::type container_type;
+        return handle(new rc_batch_impl<container_type, batch_type, Visitors...>(shape));
+      }
+      return select<typename boost::mpl::next<_Iterator>::type, _End>::apply(shape);
+    }
+  };
+  template <typename _End>
+  struct select<_End, _End> {
+    static handle apply(std::uint64_t) { return handle(); }
+  };
+};
+
+}; // namespace gNeric
+
+#endif
@@ -0,0 +1,170 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_SHARDED_H
+#define RC_SHARDED_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_sharded.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Per-thread replicas of a runtime container
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// A sharded container keeps one replica of a runtime container per worker
+// thread, every replica starts on its own cache line. The workers update
+// their replica without any synchronization, the replicas are combined
+// level by level with reduce after the workers have finished.
+//
+// Usage:
+//   ShardedContainer<container_type> sharded(nworkers);
+//   // in worker thread w
+//   sharded.apply(w, index, add_value<int>(1));
+//   // after joining the workers
+//   container_type total = sharded.reduce();
+//
+// The worker index is provided by the caller, e.g. the index of the thread in
+// a pool. Each worker index must only be used by one thread at a time.
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace gNeric
+{
+/**
+ * @brief Default reduction operation, adds the values
+ */
+struct rc_sum {
+  template <typename T>
+  void operator()(T& accumulator, const T& value)
+  {
+    accumulator += value;
+  }
+};
+
+/**
+ * @class ShardedContainer
+ * @brief Cache line aligned per-worker replicas of a runtime container
+ *
+ * @tparam ContainerT  container type created by create_rtc
+ * @tparam Alignment   alignment of the replicas, the cache line size
+ */
+template <typename ContainerT, std::size_t Alignment = 64>
+class ShardedContainer
+{
+ public:
+  typedef ContainerT container_type;
+
+  explicit ShardedContainer(std::size_t nShards)
+    : mNShards(nShards > 0 ? nShards : 1)
+    , mStorage(new char[mNShards * Stride + Alignment])
+    , mShards(nullptr)
+  {
+    void* begin = mStorage.get();
+    std::size_t space = mNShards * Stride + Alignment;
+    mShards = static_cast<char*>(std::align(Alignment, mNShards * Stride, begin, space));
+    std::size_t i = 0;
+    try {
+      for (; i < mNShards; i++) {
+        new (mShards + i * Stride) ContainerT;
+      }
+    } catch (...) {
+      // the destructor is not called, destroy the replicas constructed so far
+      while (i > 0) {
+        shard(--i).~ContainerT();
+      }
+      throw;
+    }
+  }
+  ~ShardedContainer()
+  {
+    for (std::size_t i = 0; i < mNShards; i++) {
+      shard(i).~ContainerT();
+    }
+  }
+
+  /// number of replicas
+  std::size_t size() const { return mNShards; }
+
+  /// the replica of a worker
+  ContainerT& shard(std::size_t worker) { return *reinterpret_cast<ContainerT*>(mShards + worker * Stride); }
+  const ContainerT& shard(std::size_t worker) const
+  {
+    return *reinterpret_cast<const ContainerT*>(mShards + worker * Stride);
+  }
+
+  /// apply functor to level index of the replica of a worker
+  template <typename F>
+  typename F::return_type apply(std::size_t worker, int index, F f)
+  {
+    return shard(worker).apply(index, f);
+  }
+
+  /// reset all replicas to the state after construction
+  void clear()
+  {
+    for (std::size_t i = 0; i < mNShards; i++) {
+      shard(i) = ContainerT();
+    }
+  }
+
+  /**
+   * Combine all replicas level by level
+   *
+   * The result is initialized from the first replica, the others are folded
+   * into it by calling op(accumulator, value) with the members of each level.
+   */
+  template <typename Op>
+  ContainerT reduce(Op op) const
+  {
+    ContainerT result(shard(0));
+    result.for_each(fold_level<Op>(*this, op));
+    return result;
+  }
+  ContainerT reduce() const { return reduce(rc_sum()); }
+
+ private:
+  ShardedContainer(); // forbidden
+  ShardedContainer(const ShardedContainer&); // forbidden
+  ShardedContainer& operator=(const ShardedContainer&); // forbidden
+
+  /// fold the members of one level of all replicas into the result
+  template <typename Op>
+  class fold_level
+  {
+   public:
+    typedef void return_type;
+    fold_level(const ShardedContainer& sharded, Op& op) : mSharded(sharded), mOp(op) {}
+    template <typename T>
+    return_type operator()(T& stage)
+    {
+      for (std::size_t i = 1; i < mSharded.size(); i++) {
+        mOp(stage.modify(), *static_cast<const T&>(mSharded.shard(i)));
+      }
+    }
+
+   private:
+    const ShardedContainer& mSharded;
+    Op& mOp;
+  };
+
+  static const std::size_t Stride = (sizeof(ContainerT) + Alignment - 1) / Alignment * Alignment;
+
+  std::size_t mNShards;
+  std::unique_ptr<char[]> mStorage;
+  char* mShards;
+};
+
+}; // namespace gNeric
+
+#endif
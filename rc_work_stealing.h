@@ -0,0 +1,267 @@
+//-*- Mode: C++ -*-
+
+#ifndef RC_WORK_STEALING_H
+#define RC_WORK_STEALING_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Author(s): agent <agent@local>                                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   rc_work_stealing.h
+/// @author agent
+/// @since  2026-10-18
+/// @brief  Work-stealing scheduler for chunked per-level work
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// The work on the levels of a container is split into chunks of items, e.g.
+// samples drawn from the distribution of each level. The chunks are tasks
+// which are distributed over the deques of the workers in contiguous blocks,
+// like a static partitioning. A worker takes tasks from the back of its own
+// deque, when it is empty it steals from the front of the deques of the other
+// workers. Levels with expensive items do not leave the other workers idle.
+//
+// Usage:
+//   rc_work_stealing_scheduler scheduler(4);
+//   scheduler.for_each_chunked(container, sample_chunk(results), nitems, 4096);
+//
+// The functor is called for a chunk of a level as f(stage, begin, end), every
+// worker uses its own copy of the functor. Chunks of the same level run
+// concurrently, the functor must only write to data of its chunk. With
+// steal = false the scheduler keeps the static partitioning for comparison.
+// The counters of the workers are available after each call.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gNeric
+{
+/**
+ * @brief Call a chunk functor for the level it is applied to
+ */
+template <typename F>
+class rc_chunk_functor
+{
+ public:
+  typedef void return_type;
+  rc_chunk_functor(F& f, std::size_t begin, std::size_t end) : mFunctor(f), mBegin(begin), mEnd(end) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    mFunctor(stage, mBegin, mEnd);
+  }
+
+ private:
+  rc_chunk_functor(); // forbidden
+  F& mFunctor;
+  std::size_t mBegin;
+  std::size_t mEnd;
+};
+
+/**
+ * @brief Counters of a worker for the last call
+ */
+struct rc_worker_stats {
+  std::size_t executed; // executed chunks
+  std::size_t stolen;   // chunks stolen from other workers
+  double busyTime;      // time in the functor in s
+};
+
+/**
+ * @class rc_work_stealing_scheduler
+ * @brief Pool of workers with per-worker task deques and stealing
+ */
+class rc_work_stealing_scheduler
+{
+ public:
+  explicit rc_work_stealing_scheduler(std::size_t nWorkers, bool steal = true)
+    : mSteal(steal), mGeneration(0), mStop(false), mActive(0), mStats(nWorkers > 0 ? nWorkers : 1)
+  {
+    for (std::size_t i = 0; i < mStats.size(); i++) mQueues.emplace_back(new worker_queue);
+    for (std::size_t i = 0; i < mStats.size(); i++) {
+      mThreads.emplace_back([this, i]() { run(i); });
+    }
+  }
+  ~rc_work_stealing_scheduler()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mStart.notify_all();
+    for (auto& thread : mThreads) thread.join();
+  }
+
+  /// apply f to nItems[level] items of every level in chunks of chunkSize
+  template <typename ContainerT, typename F>
+  void for_each_chunked(ContainerT& container, F f, const std::vector<std::size_t>& nItems, std::size_t chunkSize)
+  {
+    if (chunkSize == 0) chunkSize = 1;
+    std::vector<task> tasks;
+    for (std::size_t level = 0; level < container.size() && level < nItems.size(); level++) {
+      for (std::size_t begin = 0; begin < nItems[level]; begin += chunkSize) {
+        task t = {(int)level, begin, std::min(begin + chunkSize, nItems[level])};
+        tasks.push_back(t);
+      }
+    }
+    if (tasks.empty()) return;
+
+    // static partitioning: contiguous blocks of tasks per worker
+    const std::size_t nWorkers = mQueues.size();
+    for (std::size_t w = 0; w < nWorkers; w++) {
+      std::deque<task>& queue = mQueues[w]->tasks;
+      queue.assign(tasks.begin() + tasks.size() * w / nWorkers, tasks.begin() + tasks.size() * (w + 1) / nWorkers);
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mJob = [&container, f](const task& t) mutable {
+      container.apply(t.level, rc_chunk_functor<F>(f, t.begin, t.end));
+    };
+    mActive = nWorkers;
+    mGeneration++;
+    mStart.notify_all();
+    mDone.wait(lock, [this]() { return mActive == 0; });
+    mJob = nullptr;
+  }
+
+  /// apply f to nItems items of every level in chunks of chunkSize
+  template <typename ContainerT, typename F>
+  void for_each_chunked(ContainerT& container, F f, std::size_t nItems, std::size_t chunkSize)
+  {
+    for_each_chunked(container, f, std::vector<std::size_t>(container.size(), nItems), chunkSize);
+  }
+
+  std::size_t size() const { return mThreads.size(); }
+  /// counters of the workers for the last call
+  const std::vector<rc_worker_stats>& stats() const { return mStats; }
+
+ private:
+  rc_work_stealing_scheduler(const rc_work_stealing_scheduler&); // forbidden
+  rc_work_stealing_scheduler& operator=(const rc_work_stealing_scheduler&); // forbidden
+
+  struct task {
+    int level;
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  /// the queues are padded to separate cache lines instead of aligned, they
+  /// are allocated with new, which does not support over-aligned types
+  /// before C++17
+  struct worker_queue {
+    worker_queue() { lock.clear(); }
+    void acquire()
+    {
+      while (lock.test_and_set(std::memory_order_acquire)) {
+      }
+    }
+    void release() { lock.clear(std::memory_order_release); }
+    /// owner takes from the back
+    bool pop(task& t)
+    {
+      acquire();
+      bool found = !tasks.empty();
+      if (found) {
+        t = tasks.back();
+        tasks.pop_back();
+      }
+      release();
+      return found;
+    }
+    /// thieves take from the front
+    bool steal(task& t)
+    {
+      acquire();
+      bool found = !tasks.empty();
+      if (found) {
+        t = tasks.front();
+        tasks.pop_front();
+      }
+      release();
+      return found;
+    }
+
+    char headPadding[64];
+    std::atomic_flag lock;
+    std::deque<task> tasks;
+    char endPadding[64];
+  };
+
+  void run(std::size_t self)
+  {
+    typedef std::chrono::steady_clock steady_clock;
+    std::size_t generation = 0;
+    while (true) {
+      std::function<void(const task&)> job;
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mStart.wait(lock, [this, generation]() { return mStop || mGeneration != generation; });
+        if (mStop) return;
+        generation = mGeneration;
+        job = mJob; // each worker has its own copy of the functor
+      }
+      // the counters of all workers are neighbours in mStats, they are
+      // accumulated locally and stored once per call
+      rc_worker_stats stats = {0, 0, 0.};
+      task t;
+      while (true) {
+        bool stolen = false;
+        if (!mQueues[self]->pop(t)) {
+          if (!mSteal || !steal(self, t)) break;
+          stolen = true;
+        }
+        steady_clock::time_point begin = steady_clock::now();
+        job(t);
+        stats.busyTime += std::chrono::duration<double>(steady_clock::now() - begin).count();
+        stats.executed++;
+        if (stolen) stats.stolen++;
+      }
+      mStats[self] = stats;
+      // tasks are only created by for_each_chunked, a worker which finds
+      // no task has nothing left to do in this call, the call returns when
+      // all workers are done
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (--mActive == 0) mDone.notify_one();
+    }
+  }
+
+  bool steal(std::size_t self, task& t)
+  {
+    const std::size_t nWorkers = mQueues.size();
+    for (std::size_t i = 1; i < nWorkers; i++) {
+      if (mQueues[(self + i) % nWorkers]->steal(t)) return true;
+    }
+    return false;
+  }
+
+  bool mSteal;
+  std::mutex mMutex;
+  std::condition_variable mStart;
+  std::condition_variable mDone;
+  std::function<void(const task&)> mJob;
+  std::size_t mGeneration;
+  bool mStop;
+  std::size_t mActive;
+  std::vector<rc_worker_stats> mStats;
+  std::vector<std::unique_ptr<worker_queue>> mQueues;
+  std::vector<std::thread> mThreads;
+};
+
+}; // namespace gNeric
+
+#endif
@@ -25,12 +25,19 @@
 // type. Every data type in the sequence describes a mixin on top of
 // the previous one. The runtime container accumulates the type
 // properties.
+//
+// With a tracking policy, the accessors changing a member mark its level as
+// modified: set, emplace, take, modify, modify<Tag>, the assignment operators
+// and the set_value/add_value functors. The raw references returned by the
+// non-const operator* and get<Tag> bypass the tracking, changes through them
+// are not marked.
 
 #include <boost/mpl/at.hpp>
 #include <boost/mpl/begin.hpp>
+#include <boost/mpl/count_if.hpp>
 #include <boost/mpl/deref.hpp>
 #include <boost/mpl/end.hpp>
-#include <boost/mpl/equal.hpp>
+#include <boost/mpl/find_if.hpp>
 #include <boost/mpl/fold.hpp>
 #include <boost/mpl/lambda.hpp>
 #include <boost/mpl/less.hpp>
@@ -41,8 +48,18 @@
 #include <boost/mpl/range_c.hpp>
 #include <boost/mpl/size.hpp>
 #include <boost/mpl/vector.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
 
 using namespace boost::mpl::placeholders;
 
@@ -101,6 +118,40 @@ struct funny_initializer {
   }
 };
 
+/**
+ * @brief Clear a member, keeping the allocated capacity of standard containers
+ * Members with a clear() function are cleared, all others are assigned a
+ * default constructed value.
+ */
+template <typename T>
+auto rc_clear_member(T& v, int) -> decltype(v.clear(), void())
+{
+  v.clear();
+}
+template <typename T>
+void rc_clear_member(T& v, long)
+{
+  v = T();
+}
+
+/**
+ * @brief Reset a member through the initializer policy
+ * An initializer can define reset(T&) to restore the state after
+ * construction, otherwise the member is cleared and the initializer is
+ * applied again.
+ */
+template <typename Init, typename T>
+auto rc_reset_member(Init& init, T& v, int) -> decltype(init.reset(v), void())
+{
+  init.reset(v);
+}
+template <typename Init, typename T>
+void rc_reset_member(Init& init, T& v, long)
+{
+  rc_clear_member(v, 0);
+  init(v);
+}
+
 /**
  * @brief Default printer prints nothing
  */
@@ -140,6 +191,81 @@ typedef recursive_printer verbose_printer;
 struct single_printer : verbose_printer_base<false> {
 };
 
+/**
+ * @brief Default tracking policy does not track changes
+ */
+struct no_tracking {
+  template <int Level>
+  void mark()
+  {
+  }
+};
+
+/**
+ * @brief Tracking policy for modified levels
+ * Every modification of a container level marks the level in a bitmask,
+ * the marked levels can be visited with the container's for_each_dirty
+ * function, which also clears the mask. Changes through raw references are
+ * not marked, see the file comment. The maximum number of levels is a
+ * template parameter, the check is done at compile time.
+ */
+template <std::size_t MaxLevels = 64>
+class dirty_tracking
+{
+ public:
+  dirty_tracking() : mMask() {}
+
+  /// mark level as modified
+  template <int Level>
+  void mark()
+  {
+    static_assert(Level < MaxLevels, "container level out of range of the dirty mask");
+    mMask[Level / 64] |= std::uint64_t(1) << (Level % 64);
+  }
+  /// check if level is marked
+  bool test(int level) const { return mMask[level / 64] & (std::uint64_t(1) << (level % 64)); }
+  /// check if any level is marked
+  bool any() const
+  {
+    for (auto word : mMask) {
+      if (word) return true;
+    }
+    return false;
+  }
+  /// clear all marks
+  void clear()
+  {
+    for (auto& word : mMask) {
+      word = 0;
+    }
+  }
+  /// call f(level) for all marked levels in ascending order
+  template <typename F>
+  void for_each(F f) const
+  {
+    for (std::size_t i = 0; i < NWords; i++) {
+      for (std::uint64_t word = mMask[i]; word != 0; word &= word - 1) {
+        f(static_cast<int>(i * 64 + __builtin_ctzll(word)));
+      }
+    }
+  }
+
+ private:
+  static const std::size_t NWords = (MaxLevels + 63) / 64;
+  std::uint64_t mMask[NWords];
+};
+
+/**
+ * @brief Default instrumentation policy, the scope compiles to nothing
+ * The instrumentation policy opens a scope around every functor call of
+ * apply and for_each, see rc_timing_instrumentation in rc_instrumentation.h
+ */
+struct no_instrumentation {
+  struct scope {
+    explicit scope(int) {}
+  };
+};
+
 /**
  * @brief Setter functor, forwards to the container mixin's set function
  */
@@ -154,7 +280,7 @@ class set_value
   template <typename T>
   return_type operator()(T& t)
   {
-    *t = mValue;
+    t.modify() = mValue;
   }
 
  private:
@@ -176,7 +302,7 @@ class add_value
   template <typename T>
   return_type operator()(T& t)
   {
-    *t += mValue;
+    t.modify() += mValue;
   }
 
  private:
@@ -234,6 +360,73 @@ class get_value
   }
 };
 
+/**
+ * @brief Forward to a functor by reference
+ * apply and for_each take the functor by value, the wrapper keeps one
+ * functor with its state for all calls.
+ */
+template <typename F>
+class rc_functor_ref
+{
+ public:
+  typedef typename F::return_type return_type;
+  explicit rc_functor_ref(F& f) : mFunctor(f) {}
+  template <typename T>
+  return_type operator()(T& stage)
+  {
+    return mFunctor(stage);
+  }
+
+ private:
+  F& mFunctor;
+};
+
+/**
+ * @brief Bounds policies for the runtime dispatch of apply
+ * The policy decides what happens if the index passed to apply is out of
+ * the range of container levels.
+ * - rc_bounds_default    returns a value initialized return_type
+ * - rc_bounds_unchecked  the index is promised to be in range, the compiler
+ *                        can drop the last bound test, an index out of range
+ *                        is undefined behavior
+ * - rc_bounds_throw      throws std::out_of_range
+ * An error code variant is provided by apply(index, f, ec).
+ */
+struct rc_bounds_default {
+  template <typename R>
+  static R out_of_range(int)
+  {
+    return R();
+  }
+};
+
+struct rc_bounds_unchecked {
+  template <typename R>
+  static R out_of_range(int)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_unreachable();
+#elif defined(_MSC_VER)
+    __assume(0);
+#else
+    std::abort();
+#endif
+  }
+};
+
+struct rc_bounds_throw {
+  template <typename R>
+  static R out_of_range(int position)
+  {
+    throw std::out_of_range("runtime container: level index " + std::to_string(position) + " out of range");
+  }
+};
+
+// bounds policy of apply, can be changed at compile time
+#ifndef RC_BOUNDS_POLICY
+#define RC_BOUNDS_POLICY rc_bounds_default
+#endif
+
 /******************************************************************************
  * @brief apply functor to the wrapped member object in the runtime container
  * This meta function recurses through the list while incrementing the index
@@ -252,6 +445,8 @@ template <typename _ContainerT // container type
           _IndexT _Index // current index
           ,
           typename F // functor
+          ,
+          typename Bounds = rc_bounds_default // bounds policy
           >
 struct rc_apply_at {
   static typename F::return_type apply(_ContainerT& c, _IndexT position, F& f)
@@ -266,8 +461,8 @@ struct rc_apply_at {
       return f(stage);
     } else {
       // go to next element
-      return rc_apply_at<_ContainerT, _IndexT, typename boost::mpl::next<_Iterator>::type, _End, _Index + 1, F>::apply(
-        c, position, f);
+      return rc_apply_at<_ContainerT, _IndexT, typename boost::mpl::next<_Iterator>::type, _End, _Index + 1, F,
+                         Bounds>::apply(c, position, f);
     }
   }
 };
@@ -283,13 +478,13 @@ template <typename _ContainerT // container type
           _IndexT _Index // current index
           ,
           typename F // functor
+          ,
+          typename Bounds // bounds policy
           >
-struct rc_apply_at<_ContainerT, _IndexT, _End, _End, _Index, F> {
-  static typename F::return_type apply(_ContainerT& c, _IndexT position, F& f)
+struct rc_apply_at<_ContainerT, _IndexT, _End, _End, _Index, F, Bounds> {
+  static typename F::return_type apply(_ContainerT&, _IndexT position, F&)
   {
-    // TODO: this is probably the place to throw an exeption because
-    // we are out of bound
-    return typename F::return_type(0);
+    return Bounds::template out_of_range<typename F::return_type>(position);
   }
 };
 
@@ -316,13 +511,13 @@ struct rc_apply {
  * the recursive call because 'Position' is set to out of list range.
  */
 template <typename _ContainerT, typename F, typename Position = boost::mpl::size<typename _ContainerT::types>,
-          typename _IndexT = int>
+          typename _IndexT = int, typename Bounds = rc_bounds_default>
 struct rc_dispatcher {
   typedef typename _ContainerT::types types;
   typedef typename boost::mpl::if_<boost::mpl::less<Position, boost::mpl::size<types>>,
                                    rc_apply<_ContainerT, typename boost::mpl::at<types, Position>::type, _IndexT, F>,
                                    rc_apply_at<_ContainerT, _IndexT, typename boost::mpl::begin<types>::type,
-                                               typename boost::mpl::end<types>::type, 0, F>>::type type;
+                                               typename boost::mpl::end<types>::type, 0, F, Bounds>>::type type;
 
   static typename F::return_type apply(_ContainerT& c, _IndexT position, F& f) { return type::apply(c, position, f); }
 };
@@ -336,12 +531,23 @@ struct rc_dispatcher {
  *
  * The level of the mixin is encoded in the type 'level' which is
  * incremented in each mixin stage.
+ *
+ * The policies:
+ * - InterfacePolicy    the common base of the mixin
+ * - InitializerPolicy  initializes the member of each level
+ * - PrinterPolicy      prints the member of each level
+ * - TrackingPolicy     tracks modifications of the levels, see dirty_tracking
+ * - InstrumentationPolicy  scope around the functor calls, see rc_instrumentation.h
  */
 template <typename InterfacePolicy = DefaultInterface, typename InitializerPolicy = default_initializer,
-          typename PrinterPolicy = default_printer>
+          typename PrinterPolicy = default_printer, typename TrackingPolicy = no_tracking,
+          typename InstrumentationPolicy = no_instrumentation>
 struct RuntimeContainer : public InterfacePolicy {
-  InitializerPolicy _initializer;
+  /// mutable: lazy levels are initialized at the first access, also a const one
+  mutable InitializerPolicy _initializer;
   PrinterPolicy _printer;
+  TrackingPolicy _tracker;
+  typedef InstrumentationPolicy instrumentation_type;
   typedef boost::mpl::int_<-1> level;
   typedef boost::mpl::vector<>::type types;
 
@@ -352,6 +558,22 @@ struct RuntimeContainer : public InterfacePolicy {
     const char* string = "base";
     _printer(string, level::value);
   }
+  /// end of the recursive reset, restores the tracking policy
+  void reset() { _tracker = TrackingPolicy(); }
+  /// a container without levels, e.g. an empty selection of rc_shape_factory.h
+  template <typename F>
+  void for_each(F)
+  {
+  }
+
+ protected:
+  /// end of the recursive loop over all levels
+  template <typename F>
+  void _for_each(F&)
+  {
+  }
+
+ public:
 
   // not yet clear if we need the setter and getter in the base class
   // at least wrapped_type is not defined in the base
@@ -359,6 +581,222 @@ struct RuntimeContainer : public InterfacePolicy {
   // wrapped_type get() const {return mMember;}
 };
 
+/// base of container expressions, see rc_expression.h
+template <typename E>
+class rc_expression;
+
+/**
+ * @brief Tag a member type of the runtime container
+ * A level created from tagged<Tag, T> wraps a member of type T and can be
+ * addressed by the tag type with get<Tag>(). For untagged levels the member
+ * type itself is the tag.
+ *
+ * Usage: typedef boost::mpl::vector<tagged<energy_tag, float>, tagged<charge_tag, int> > types;
+ */
+template <typename Tag, typename T>
+struct tagged {
+};
+
+/**
+ * @brief Construct the member of a level on first access
+ * A level created from lazy<T> wraps a member of type T, the member is
+ * constructed and initialized by the initializer policy when it is accessed
+ * for the first time. Lazy levels can be combined with tags, e.g.
+ * tagged<Tag, lazy<T> >.
+ *
+ * Note: the member offsets of rc_reflection.h are only valid for engaged
+ * lazy levels.
+ */
+template <typename T>
+struct lazy {
+};
+
+/**
+ * @brief Storage of the member of a level, constructed with the container
+ */
+template <typename T>
+class rc_eager_storage
+{
+ public:
+  template <typename Init>
+  explicit rc_eager_storage(Init& init) : mValue()
+  {
+    init(mValue);
+  }
+  template <typename Init>
+  T& get(Init&)
+  {
+    return mValue;
+  }
+  template <typename Init>
+  const T& get(Init&) const
+  {
+    return mValue;
+  }
+  bool engaged() const { return true; }
+  template <typename Init>
+  void reset(Init& init)
+  {
+    rc_reset_member(init, mValue, 0);
+  }
+
+ private:
+  T mValue;
+};
+
+/**
+ * @brief Storage of the member of a lazy level
+ * In-place storage and an atomic state, the member is constructed at the
+ * first call of get. The first access is thread-safe, concurrent callers
+ * wait until one of them has constructed and initialized the member. The
+ * initializer policy can be called concurrently for different lazy levels.
+ * Copy, move, reset and disengage must not run concurrently with an access.
+ */
+template <typename T>
+class rc_lazy_storage
+{
+ public:
+  template <typename Init>
+  explicit rc_lazy_storage(Init&) : mState(empty)
+  {
+  }
+  rc_lazy_storage(const rc_lazy_storage& other) : mState(empty)
+  {
+    if (other.engaged()) construct(other.value());
+  }
+  rc_lazy_storage(rc_lazy_storage&& other) noexcept(std::is_nothrow_move_constructible<T>::value) : mState(empty)
+  {
+    if (other.engaged()) construct(std::move(other.value()));
+  }
+  rc_lazy_storage& operator=(const rc_lazy_storage& other)
+  {
+    if (this != &other) assign(other.engaged(), other.value());
+    return *this;
+  }
+  rc_lazy_storage& operator=(rc_lazy_storage&& other) noexcept(
+    std::is_nothrow_move_constructible<T>::value&& std::is_nothrow_move_assignable<T>::value)
+  {
+    if (this != &other) assign(other.engaged(), std::move(other.value()));
+    return *this;
+  }
+  ~rc_lazy_storage() { disengage(); }
+
+  template <typename Init>
+  T& get(Init& init) const
+  {
+    if (mState.load(std::memory_order_acquire) != engaged_state) engage(init);
+    return value();
+  }
+  bool engaged() const { return mState.load(std::memory_order_acquire) == engaged_state; }
+  /// reset an engaged member, the member is kept in place
+  template <typename Init>
+  void reset(Init& init)
+  {
+    if (engaged()) rc_reset_member(init, value(), 0);
+  }
+  /// destroy the member, the next access constructs a new one
+  void disengage()
+  {
+    if (engaged()) value().~T();
+    mState.store(empty, std::memory_order_relaxed);
+  }
+
+ private:
+  enum : unsigned char { empty, constructing, engaged_state };
+
+  T& value() const { return *reinterpret_cast<T*>(&mStorage); }
+  /// the slow path of get: construct and initialize the member once
+  template <typename Init>
+  void engage(Init& init) const
+  {
+    while (true) {
+      unsigned char state = mState.load(std::memory_order_acquire);
+      if (state == engaged_state) return;
+      if (state == empty && mState.compare_exchange_weak(state, constructing, std::memory_order_acquire)) {
+        try {
+          new (&mStorage) T();
+        } catch (...) {
+          mState.store(empty, std::memory_order_release);
+          throw;
+        }
+        try {
+          init(value());
+        } catch (...) {
+          value().~T();
+          mState.store(empty, std::memory_order_release);
+          throw;
+        }
+        mState.store(engaged_state, std::memory_order_release);
+        return;
+      }
+      std::this_thread::yield();
+    }
+  }
+  template <typename U>
+  void construct(U&& v)
+  {
+    new (&mStorage) T(std::forward<U>(v));
+    mState.store(engaged_state, std::memory_order_release);
+  }
+  template <typename U>
+  void assign(bool engaged, U&& v)
+  {
+    if (!engaged) {
+      disengage();
+    } else if (this->engaged()) {
+      value() = std::forward<U>(v);
+    } else {
+      construct(std::forward<U>(v));
+    }
+  }
+
+  mutable typename std::aligned_storage<sizeof(T), alignof(T)>::type mStorage;
+  mutable std::atomic<unsigned char> mState;
+};
+
+/**
+ * @brief Member type, tag type and storage of a container level
+ */
+template <typename T>
+struct rc_member_traits {
+  typedef T value_type;
+  typedef T tag_type;
+  typedef rc_eager_storage<T> storage_type;
+};
+
+template <typename T>
+struct rc_member_traits<lazy<T>> {
+  typedef T value_type;
+  typedef T tag_type;
+  typedef rc_lazy_storage<T> storage_type;
+};
+
+template <typename Tag, typename T>
+struct rc_member_traits<tagged<Tag, T>> {
+  typedef typename rc_member_traits<T>::value_type value_type;
+  typedef Tag tag_type;
+  typedef typename rc_member_traits<T>::storage_type storage_type;
+};
+
+/**
+ * @brief check if the container level has the specified tag
+ */
+template <typename Stage, typename Tag>
+struct rc_has_tag : boost::mpl::bool_<std::is_same<typename Stage::tag_type, Tag>::value> {
+};
+
+/**
+ * @brief find the container level for a tag
+ * The tag has to be unique among the levels of the container.
+ */
+template <typename ContainerT, typename Tag>
+struct rc_level_of {
+  typedef typename ContainerT::types types;
+  static_assert(boost::mpl::count_if<types, rc_has_tag<_1, Tag>>::value == 1,
+                "tag not found or not unique in the runtime container");
+  typedef typename boost::mpl::deref<typename boost::mpl::find_if<types, rc_has_tag<_1, Tag>>::type>::type type;
+};
+
 /**
  * @class rc_mixin Components for the mixin class
  * @brief Mixin component is used with different data types
@@ -366,6 +804,7 @@ struct RuntimeContainer : public InterfacePolicy {
  * Each mixin component has a member of the specified type. The container
  * level exports the following data types to the outside:
  * - wrapped_type    the data type at this level
+ * - tag_type        the tag of this level, see tagged
  * - mixin_type      composed type at this level
  * - types           mpl sequence containing all level types
  * - level           a data type containing the level
@@ -374,11 +813,15 @@ template <typename BASE, typename T>
 class rc_mixin : public BASE
 {
  public:
-  rc_mixin() : mMember() { BASE::_initializer(mMember); }
+  rc_mixin() : mStorage(BASE::_initializer) {}
   /// each stage of the mixin class wraps one type
-  typedef T wrapped_type;
+  typedef typename rc_member_traits<T>::value_type wrapped_type;
+  /// the storage of the member, constructed with the container or lazy
+  typedef typename rc_member_traits<T>::storage_type storage_type;
+  /// the tag to address this stage
+  typedef typename rc_member_traits<T>::tag_type tag_type;
   /// this is the self type
-  typedef rc_mixin<BASE, wrapped_type> mixin_type;
+  typedef rc_mixin<BASE, T> mixin_type;
   /// a vector of all mixin stage types so far
   typedef typename boost::mpl::push_back<typename BASE::types, mixin_type>::type types;
   /// increment the level counter
@@ -387,35 +830,116 @@ class rc_mixin : public BASE
   {
     // use the printer policy of this level, the policy returns
     // a bool determining whether to call the underlying level
-    if (BASE::_printer(mMember, level::value)) {
+    if (BASE::_printer(member(), level::value)) {
       BASE::print();
     }
   }
+  /// reset the members of all levels through the initializer policy, see
+  /// rc_reset_member, and restore the tracking policy
+  void reset()
+  {
+    mStorage.reset(BASE::_initializer);
+    BASE::reset();
+  }
 
   /// get size at this stage
   constexpr std::size_t size() const { return level::value + 1; }
   /// set member wrapped object
-  void set(wrapped_type v) { mMember = v; }
-  /// get wrapped object
-  wrapped_type get() const { return mMember; }
-  /// get wrapped object reference
-  wrapped_type& operator*() { return mMember; }
+  void set(const wrapped_type& v)
+  {
+    mark();
+    member() = v;
+  }
+  /// set member wrapped object by moving from v
+  void set(wrapped_type&& v)
+  {
+    mark();
+    member() = std::move(v);
+  }
+  /// construct a new wrapped object from the arguments and move it to the member
+  template <typename... Args>
+  void emplace(Args&&... args)
+  {
+    mark();
+    member() = wrapped_type(std::forward<Args>(args)...);
+  }
+  /// get wrapped object const reference
+  const wrapped_type& get() const { return member(); }
+  /// check if the member has been constructed, always true except for lazy levels
+  bool engaged() const { return mStorage.engaged(); }
+  /// get the member of the level with tag, does not mark the level as modified,
+  /// use modify<Tag> for changes in place
+  template <typename Tag>
+  typename rc_level_of<mixin_type, Tag>::type::wrapped_type& get()
+  {
+    return *static_cast<typename rc_level_of<mixin_type, Tag>::type&>(*this);
+  }
+  /// get the member of the level with tag for a change in place, marks the level as modified
+  template <typename Tag>
+  typename rc_level_of<mixin_type, Tag>::type::wrapped_type& modify()
+  {
+    return static_cast<typename rc_level_of<mixin_type, Tag>::type&>(*this).modify();
+  }
+  /// get const reference to the member of the level with tag
+  template <typename Tag>
+  const typename rc_level_of<mixin_type, Tag>::type::wrapped_type& get() const
+  {
+    return *static_cast<const typename rc_level_of<mixin_type, Tag>::type&>(*this);
+  }
+  /// index of the level with tag
+  template <typename Tag>
+  static constexpr int index_of()
+  {
+    return rc_level_of<mixin_type, Tag>::type::level::value;
+  }
+  /// move the wrapped object out of the container, the member is left in
+  /// the moved-from state of the wrapped type
+  wrapped_type take()
+  {
+    mark();
+    return std::move(member());
+  }
+  /// get wrapped object reference, does not mark the level as modified, use
+  /// modify for changes in place
+  wrapped_type& operator*() { return member(); }
+  /// get wrapped object reference for a change in place, marks the level as modified
+  wrapped_type& modify()
+  {
+    mark();
+    return member();
+  }
+  /// get wrapped object const reference
+  const wrapped_type& operator*() const { return member(); }
   /// assignment operator to wrapped type
   wrapped_type& operator=(const wrapped_type& v)
   {
-    mMember = v;
-    return mMember;
+    mark();
+    member() = v;
+    return member();
+  }
+  /// move assignment operator to wrapped type
+  wrapped_type& operator=(wrapped_type&& v)
+  {
+    mark();
+    member() = std::move(v);
+    return member();
   }
   /// type conversion to wrapped type
-  operator wrapped_type() const { return mMember; }
+  operator wrapped_type() const { return member(); }
   /// operator
   wrapped_type& operator+=(const wrapped_type& v)
   {
-    mMember += v;
-    return mMember;
+    mark();
+    member() += v;
+    return member();
+  }
+  /// evaluate a container expression level by level, see rc_expression.h
+  template <typename E>
+  mixin_type& operator=(const rc_expression<E>& expression)
+  {
+    rc_assign(*this, expression.self());
+    return *this;
   }
-  /// operator
-  wrapped_type operator+(const wrapped_type& v) { return mMember + v; }
   /// a functor wrapper dereferencing the RC container instance
   /// the idea is to use this extra wrapper to apply the functor directly to
   /// the wrapped type, see the comment below
@@ -458,6 +982,12 @@ class rc_mixin : public BASE
    * if the compiler optimization is switched of. This is  in the end a nice
    * demonstrator for the potential of compiler optimization. Unrolling is
    * switched on with the compile time switch RC_UNROLL.
+   *
+   * An index out of range is handled by the bounds policy RC_BOUNDS_POLICY,
+   * rc_bounds_default unless defined at compile time, see apply_bounded.
+   *
+   * The call is measured by the instrumentation policy if the index is in
+   * range.
    */
   template <typename F
 #ifdef RC_UNROLL
@@ -470,37 +1000,108 @@ class rc_mixin : public BASE
             >
   typename F::return_type apply(int index, F f)
   {
+    typename BASE::instrumentation_type::scope scope(index < (int)size() ? index : -1);
     if (unroll) { // this is a compile time switch
       // do unrolling for the first n elements and forward to generic
       // recursive function for the rest.
       switch (index) {
         case 0:
-          return rc_dispatcher<mixin_type, F, boost::mpl::int_<0>, int>::apply(*this, 0, f);
+          return rc_dispatcher<mixin_type, F, boost::mpl::int_<0>, int, RC_BOUNDS_POLICY>::apply(*this, 0, f);
         case 1:
-          return rc_dispatcher<mixin_type, F, boost::mpl::int_<1>, int>::apply(*this, 1, f);
+          return rc_dispatcher<mixin_type, F, boost::mpl::int_<1>, int, RC_BOUNDS_POLICY>::apply(*this, 1, f);
         case 2:
-          return rc_dispatcher<mixin_type, F, boost::mpl::int_<2>, int>::apply(*this, 2, f);
+          return rc_dispatcher<mixin_type, F, boost::mpl::int_<2>, int, RC_BOUNDS_POLICY>::apply(*this, 2, f);
         case 3:
-          return rc_dispatcher<mixin_type, F, boost::mpl::int_<3>, int>::apply(*this, 3, f);
+          return rc_dispatcher<mixin_type, F, boost::mpl::int_<3>, int, RC_BOUNDS_POLICY>::apply(*this, 3, f);
         case 4:
-          return rc_dispatcher<mixin_type, F, boost::mpl::int_<4>, int>::apply(*this, 4, f);
+          return rc_dispatcher<mixin_type, F, boost::mpl::int_<4>, int, RC_BOUNDS_POLICY>::apply(*this, 4, f);
         case 5:
-          return rc_dispatcher<mixin_type, F, boost::mpl::int_<5>, int>::apply(*this, 5, f);
+          return rc_dispatcher<mixin_type, F, boost::mpl::int_<5>, int, RC_BOUNDS_POLICY>::apply(*this, 5, f);
         case 6:
-          return rc_dispatcher<mixin_type, F, boost::mpl::int_<6>, int>::apply(*this, 6, f);
+          return rc_dispatcher<mixin_type, F, boost::mpl::int_<6>, int, RC_BOUNDS_POLICY>::apply(*this, 6, f);
         case 7:
-          return rc_dispatcher<mixin_type, F, boost::mpl::int_<7>, int>::apply(*this, 7, f);
+          return rc_dispatcher<mixin_type, F, boost::mpl::int_<7>, int, RC_BOUNDS_POLICY>::apply(*this, 7, f);
         case 8:
-          return rc_dispatcher<mixin_type, F, boost::mpl::int_<8>, int>::apply(*this, 8, f);
+          return rc_dispatcher<mixin_type, F, boost::mpl::int_<8>, int, RC_BOUNDS_POLICY>::apply(*this, 8, f);
         case 9:
-          return rc_dispatcher<mixin_type, F, boost::mpl::int_<9>, int>::apply(*this, 9, f);
+          return rc_dispatcher<mixin_type, F, boost::mpl::int_<9>, int, RC_BOUNDS_POLICY>::apply(*this, 9, f);
       }
     }
-    return rc_dispatcher<mixin_type, F>::apply(*this, index, f);
+    return rc_dispatcher<mixin_type, F, boost::mpl::size<types>, int, RC_BOUNDS_POLICY>::apply(*this, index, f);
+  }
+
+  /*
+   * Apply a functor to the runtime container at index with the bounds
+   * policy Bounds for an index out of range, e.g.
+   *   container.apply_bounded<rc_bounds_throw>(index, f);
+   */
+  template <typename Bounds, typename F>
+  typename F::return_type apply_bounded(int index, F f)
+  {
+    typename BASE::instrumentation_type::scope scope(index < (int)size() ? index : -1);
+    return rc_dispatcher<mixin_type, F, boost::mpl::size<types>, int, Bounds>::apply(*this, index, f);
+  }
+
+  /*
+   * Apply a functor to the runtime container at index, an index out of range
+   * sets the error code std::errc::result_out_of_range and returns a value
+   * initialized return_type. The dispatch itself is unchecked.
+   */
+  template <typename F>
+  typename F::return_type apply(int index, F f, std::error_code& ec)
+  {
+    if (index < 0 || index >= (int)size()) {
+      ec = std::make_error_code(std::errc::result_out_of_range);
+      return typename F::return_type();
+    }
+    ec.clear();
+    return apply_bounded<rc_bounds_unchecked>(index, f);
+  }
+
+  /*
+   * Apply a functor to all levels of the runtime container
+   *
+   * The levels are visited in ascending order by static recursion, there is
+   * no runtime dispatch. The functor is called with the container level like
+   * in the apply function.
+   */
+  template <typename F>
+  void for_each(F f)
+  {
+    _for_each(f);
+  }
+
+  /*
+   * Apply a functor to all modified levels and clear the marks
+   *
+   * Requires the dirty_tracking policy. The levels are visited in ascending
+   * order, the functor is dispatched to each of the marked levels.
+   */
+  template <typename F>
+  void for_each_dirty(F f)
+  {
+    BASE::_tracker.for_each([this, &f](int index) { this->apply(index, f); });
+    BASE::_tracker.clear();
+  }
+
+ protected:
+  template <typename F>
+  void _for_each(F& f)
+  {
+    BASE::_for_each(f);
+    typename BASE::instrumentation_type::scope scope(level::value);
+    f(static_cast<mixin_type&>(*this));
   }
 
+  /// mark this level as modified in the tracking policy
+  void mark() { BASE::_tracker.template mark<level::value>(); }
+
  private:
-  T mMember;
+  /// the member, constructs it for lazy levels
+  wrapped_type& member() { return mStorage.get(BASE::_initializer); }
+  const wrapped_type& member() const { return mStorage.get(BASE::_initializer); }
+
+  storage_type mStorage;
 };
 
 /**
@@ -519,8 +1120,11 @@ template <typename T, typename N>
 struct rtc_less : boost::mpl::bool_<(T::level::value < boost::mpl::minus<N, boost::mpl::int_<1>>::value)> {
 };
 
+/**
+ * @brief check if the mixin level wraps the specified type
+ */
 template <typename T, typename N>
-struct rtc_equal : boost::mpl::bool_<boost::mpl::equal<typename T::wrapped_type, N>::type> {
+struct rtc_equal : boost::mpl::bool_<std::is_same<typename T::wrapped_type, N>::value> {
 };
 
 /**
@@ -14,6 +14,24 @@
 #include <boost/mpl/plus.hpp>
 #include <boost/mpl/at.hpp>
 #include "runtime_container.h"
+#include "heterogeneous_vector.h"
+#include "rc_atomic.h"
+#include "rc_sharded.h"
+#include "rc_name_index.h"
+#include "rc_reflection.h"
+#include "rc_columnar.h"
+#include "rc_expression.h"
+#include "rc_pool.h"
+#include "rc_pipeline.h"
+#include "rc_work_stealing.h"
+#include "rc_instrumentation.h"
+#include "rc_shape_factory.h"
+#include <boost/mpl/vector_c.hpp>
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 using namespace gNeric;
 
@@ -25,6 +43,128 @@ struct int_minus : boost::mpl::int_<( N1::value - N2::value )> {};
 using boost::mpl::placeholders::_1;
 using boost::mpl::placeholders::_2;
 
+struct print_element {
+  typedef void return_type;
+  template<typename T>
+  return_type operator()(T& element) {
+    std::cout << " " << element;
+  }
+};
+
+struct doubled_element {
+  typedef float return_type;
+  template<typename T>
+  return_type operator()(T& element) {
+    return 2 * element;
+  }
+};
+
+struct print_level {
+  typedef void return_type;
+  template<typename T>
+  return_type operator()(T& stage) {
+    std::cout << "  level " << T::level::value << ": " << stage.get() << std::endl;
+  }
+};
+
+/// set the levels to consecutive numbers, the state is kept between the calls
+struct number_levels {
+  typedef void return_type;
+  number_levels() : mNext(0) {}
+  template<typename T>
+  return_type operator()(T& stage) {
+    stage.set(mNext++);
+  }
+  int mNext;
+};
+
+/// count the levels with a member equal to the value
+struct count_equal {
+  typedef void return_type;
+  count_equal(int value, int& count) : mValue(value), mCount(count) {}
+  template<typename T>
+  return_type operator()(T& stage) {
+    if (stage.get() == static_cast<typename T::wrapped_type>(mValue)) mCount++;
+  }
+  int mValue;
+  int& mCount;
+};
+
+/// replica type throwing in the constructor of the third instance
+struct throwing_shard {
+  static int instances;
+  static int alive;
+  throwing_shard() {
+    if (++instances == 3) throw std::runtime_error("third replica");
+    alive++;
+  }
+  ~throwing_shard() { alive--; }
+};
+int throwing_shard::instances = 0;
+int throwing_shard::alive = 0;
+
+/// read-only functor accessing the members through the non-const level
+struct count_levels {
+  typedef void return_type;
+  count_levels(int& count) : mCount(count) {}
+  template<typename T>
+  return_type operator()(T& stage) {
+    const typename T::wrapped_type& member = *stage;
+    (void)member;
+    mCount++;
+  }
+  int& mCount;
+};
+
+struct energy_tag {
+  static constexpr const char* name() { return "energy"; }
+};
+struct charge_tag {
+  static constexpr const char* name() { return "charge"; }
+};
+struct label_tag {
+  static constexpr const char* name() { return "label"; }
+};
+struct a_tag {
+  static constexpr const char* name() { return "a"; }
+};
+struct b_tag {
+  static constexpr const char* name() { return "b"; }
+};
+struct x_tag {
+  static constexpr const char* name() { return "x"; }
+};
+struct y_tag {
+  static constexpr const char* name() { return "y"; }
+};
+
+struct print_engaged {
+  typedef void return_type;
+  template<typename T>
+  return_type operator()(T& stage) {
+    std::cout << " " << stage.engaged();
+  }
+};
+
+struct counting_initializer {
+  counting_initializer() : mCount(0) {}
+  template<typename T>
+  void operator()(T&) {
+    mCount++;
+  }
+  int mCount;
+};
+
+struct fill_chunk {
+  typedef void return_type;
+  fill_chunk(std::vector<std::vector<double> >& results) : mResults(results) {}
+  template<typename T>
+  return_type operator()(T& stage, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; i++) mResults[T::level::value][i] = stage.get() + i;
+  }
+  std::vector<std::vector<double> >& mResults;
+};
+
 struct print_container {
   template<typename T>
   void operator()(T t) {
@@ -33,6 +173,17 @@ struct print_container {
   }
 };
 
+/// number of failed checks, the return code of the program
+int failures = 0;
+
+/// compare a result with the expected value and count the failures
+template<typename T, typename U>
+void check(const char* what, const T& result, const U& expected) {
+  if (result == expected) return;
+  std::cout << "  FAILED " << what << ": " << result << ", expected " << expected << std::endl;
+  failures++;
+}
+
 int main()
 {
   ////////////////////////////////////////////////////////////////////////////////
@@ -48,7 +199,7 @@ int main()
   t1 v1; t2 v2; t3 v3; t4 v4;
 
   std::cout << "example for boost::mpl::apply:" << std::endl;
-  std::cout << "int_minus meta fct:   " << t1::value << " - " << t2::value << " = " << v3.value << std::endl;
+  std::cout << "int_minus meta fct:   " << v1.value << " - " << v2.value << " = " << v3.value << std::endl;
   std::cout << "reverse placeholders: " << t2::value << " - " << t1::value << " = " << v4.value << std::endl;
   std::cout << std::endl;
 
@@ -113,4 +264,455 @@ int main()
   std::cout << std::endl << "testing cloning using copy constructor" << std::endl;
   std::unique_ptr<Container_t> clone(new Container_t(container));
   clone->print();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing dirty tracking" << std::endl;
+  typedef RuntimeContainer<DefaultInterface, funny_initializer, default_printer, dirty_tracking<> > TrackingBase_t;
+  typedef create_rtc< types, TrackingBase_t >::type TrackingContainer_t;
+  TrackingContainer_t tracking;
+  std::cout << "modified after construction: " << (tracking._tracker.any() ? "yes" : "no") << std::endl;
+  check("modified after construction", tracking._tracker.any(), false);
+  int nread = 0;
+  tracking.for_each(count_levels(nread));
+  check("levels read", nread, (int)tracking.size());
+  check("modified after reading", tracking._tracker.any(), false);
+  tracking.apply(1, set_value<char>('x'));
+  static_cast<boost::mpl::at_c<TrackingContainer_t::types, 3>::type&>(tracking) += 1.f;
+  for (int level = 0; level < (int)tracking.size(); level++) {
+    check("level marked", tracking._tracker.test(level), level == 1 || level == 3);
+  }
+  std::cout << "modified levels:" << std::endl;
+  tracking.for_each_dirty(print_level());
+  std::cout << "modified after for_each_dirty: " << (tracking._tracker.any() ? "yes" : "no") << std::endl;
+  check("modified after for_each_dirty", tracking._tracker.any(), false);
+  typedef boost::mpl::vector<tagged<energy_tag, float>, tagged<charge_tag, int>, tagged<label_tag, char> > tracked_tagged_types;
+  create_rtc< tracked_tagged_types, TrackingBase_t >::type taggedTracking;
+  taggedTracking.get<charge_tag>() = 2;
+  *static_cast<boost::mpl::at_c<decltype(taggedTracking)::types, 2>::type&>(taggedTracking) = 'y';
+  check("raw references not marked", taggedTracking._tracker.any(), false);
+  taggedTracking.modify<energy_tag>() = 1.5f;
+  taggedTracking.modify<charge_tag>() += 3;
+  check("modify<Tag> value", taggedTracking.get<charge_tag>(), 5);
+  for (int level = 0; level < 3; level++) {
+    check("modify<Tag> marked", taggedTracking._tracker.test(level), level != 2);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing atomic members" << std::endl;
+  typedef boost::mpl::vector<int, double, long double> atomic_types;
+  typedef create_rtc< rc_atomic_types<atomic_types>::type, RuntimeContainer<> >::type AtomicContainer_t;
+  AtomicContainer_t atomics;
+  atomics.apply(0, set_value<int>(10));
+  std::thread worker([&atomics]() {
+      for (int i = 0; i < 1000; i++) atomics.apply(i % 3, add_value<int>(1));
+    });
+  for (int i = 0; i < 1000; i++) atomics.apply(i % 3, add_value<int>(1));
+  worker.join();
+  const double atomicSums[3] = {10 + 2 * 334, 2 * 333, 2 * 333};
+  for (int i = 0; i < 3; i++) {
+    std::cout << "  level " << i << ": " << atomics.apply(i, get_value<double>()) << std::endl;
+    check("atomic level sum", atomics.apply(i, get_value<double>()), atomicSums[i]);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing sharded container" << std::endl;
+  typedef create_rtc< atomic_types, RuntimeContainer<> >::type PlainContainer_t;
+  ShardedContainer<PlainContainer_t> sharded(2);
+  std::thread shardWorker([&sharded]() {
+      for (int i = 0; i < 1000; i++) sharded.apply(1, i % 3, add_value<int>(1));
+    });
+  for (int i = 0; i < 1000; i++) sharded.apply(0, i % 3, add_value<int>(2));
+  shardWorker.join();
+  PlainContainer_t reduced = sharded.reduce();
+  const double shardedSums[] = {1002., 999., 999.};
+  for (int i = 0; i < 3; i++) {
+    std::cout << "  level " << i << ": " << reduced.apply(i, get_value<double>()) << std::endl;
+    check("reduced level", reduced.apply(i, get_value<double>()), shardedSums[i]);
+  }
+  bool shardThrown = false;
+  try {
+    ShardedContainer<throwing_shard> throwing(4);
+  } catch (const std::runtime_error&) {
+    shardThrown = true;
+  }
+  check("exception of the replica constructor", shardThrown, true);
+  check("replicas alive after the exception", throwing_shard::alive, 0);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing move semantics" << std::endl;
+  typedef create_rtc< boost::mpl::vector<std::string, std::vector<int> >, RuntimeContainer<> >::type HeavyContainer_t;
+  HeavyContainer_t heavy;
+  std::string text("a string long enough to be allocated on the heap");
+  static_cast<boost::mpl::at_c<HeavyContainer_t::types, 0>::type&>(heavy).set(std::move(text));
+  heavy.emplace(5, 7);
+  std::cout << "level 0 after set from rvalue: " << static_cast<boost::mpl::at_c<HeavyContainer_t::types, 0>::type&>(heavy).get() << std::endl;
+  std::cout << "level 1 after emplace: " << heavy.get().size() << " elements" << std::endl;
+  check("level 0 after set from rvalue", static_cast<boost::mpl::at_c<HeavyContainer_t::types, 0>::type&>(heavy).get(),
+        std::string("a string long enough to be allocated on the heap"));
+  check("level 1 after emplace", heavy.get() == std::vector<int>(5, 7), true);
+  HeavyContainer_t moved(std::move(heavy));
+  std::vector<int> taken = moved.take();
+  std::cout << "taken " << taken.size() << " elements, left " << moved.get().size() << std::endl;
+  check("taken elements", taken.size(), 5u);
+  check("elements left", moved.get().size(), 0u);
+  moved = std::move(taken);
+  std::cout << "moved back " << moved.get().size() << " elements" << std::endl;
+  check("moved back", moved.get() == std::vector<int>(5, 7), true);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing tagged levels" << std::endl;
+  typedef boost::mpl::vector<tagged<energy_tag, float>, tagged<charge_tag, int>, tagged<label_tag, char> > tagged_types;
+  typedef create_rtc< tagged_types, RuntimeContainer<> >::type TaggedContainer_t;
+  TaggedContainer_t tagged_container;
+  tagged_container.get<energy_tag>() = 1.5f;
+  tagged_container.get<charge_tag>() = -1;
+  tagged_container.get<label_tag>() = 'e';
+  static_assert(TaggedContainer_t::index_of<charge_tag>() == 1, "wrong index of tagged level");
+  static_assert(rc_name_index<TaggedContainer_t>::find("label") == 2, "wrong index of level name");
+  static_assert(rc_perfect_hash<0>().find(rc_name_hash("label")) == -1, "empty perfect hash table");
+  static_assert(rc_perfect_hash<100>::Size == 256, "perfect hash table is not linear in the number of keys");
+  static_assert(rtc_equal<boost::mpl::at_c<TaggedContainer_t::types, 0>::type, float>::value, "rtc_equal failed");
+  const char* names[] = {"charge", "energy", "label", "momentum"};
+  for (auto name : names) {
+    int index = rc_name_index<TaggedContainer_t>::find(std::string(name));
+    std::cout << "  " << name << ": index " << index;
+    if (index >= 0) {
+      std::cout << " value " << tagged_container.apply(index, get_value<float>());
+    }
+    std::cout << std::endl;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing reflection table" << std::endl;
+  typedef rc_reflection<TaggedContainer_t> reflection;
+  std::size_t memberBytes = 0;
+  for (auto& level : reflection::levels()) {
+    std::cout << "  level " << level.index << ": " << std::setw(8) << level.tag_name << " " << std::setw(6) << level.type_name
+              << " size " << level.size << " align " << level.align << " offset " << level.offset << std::endl;
+    memberBytes += level.size;
+  }
+  std::cout << "  member bytes " << memberBytes << " of " << sizeof(TaggedContainer_t) << std::endl;
+  std::cout << "  energy via offset: " << *static_cast<float*>(reflection::address(tagged_container, 0)) << std::endl;
+  const std::size_t levelSizes[3] = {sizeof(float), sizeof(int), sizeof(char)};
+  const std::size_t levelAligns[3] = {alignof(float), alignof(int), alignof(char)};
+  const std::string tagNames[3] = {"energy", "charge", "label"};
+  for (int i = 0; i < 3; i++) {
+    check("reflection index", reflection::level(i).index, i);
+    check("reflection size", reflection::level(i).size, levelSizes[i]);
+    check("reflection align", reflection::level(i).align, levelAligns[i]);
+    check("reflection tag name", std::string(reflection::level(i).tag_name), tagNames[i]);
+  }
+  static_assert(reflection::static_level<1>().size == sizeof(int), "wrong size of reflected level");
+  static_assert(reflection::static_level<2>().align == alignof(char), "wrong alignment of reflected level");
+  check("reflection energy via offset", *static_cast<float*>(reflection::address(tagged_container, 0)), 1.5f);
+  *static_cast<int*>(reflection::address(tagged_container, 1)) = 7;
+  check("reflection charge written via offset", tagged_container.get<charge_tag>(), 7);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing columnar format" << std::endl;
+  std::vector<TaggedContainer_t> rows(5);
+  for (int row = 0; row < 5; row++) {
+    rows[row].get<energy_tag>() = 0.5f * row;
+    rows[row].get<charge_tag>() = row % 2 ? 1 : -1;
+    rows[row].get<label_tag>() = 'a' + row;
+  }
+  std::stringstream stream;
+  {
+    rc_column_writer<TaggedContainer_t> writer(stream, 2);
+    writer.write(rows.begin(), rows.end());
+  }
+  rc_column_reader<TaggedContainer_t> reader(stream);
+  reader.select({0, 2});
+  std::vector<TaggedContainer_t> block;
+  std::vector<std::size_t> blockRows;
+  int readRow = 0;
+  while (reader.read(block) > 0) {
+    std::cout << "  block of " << block.size() << " rows, " << reader.level_name(0) << "/" << reader.level_name(2) << ":";
+    for (auto& row : block) {
+      std::cout << " " << row.get<energy_tag>() << "/" << row.get<label_tag>();
+      check("columnar energy", row.get<energy_tag>(), 0.5f * readRow);
+      check("columnar label", row.get<label_tag>(), char('a' + readRow));
+      readRow++;
+    }
+    std::cout << std::endl;
+    blockRows.push_back(block.size());
+  }
+  check("columnar rows per block", blockRows == std::vector<std::size_t>{2, 2, 1}, true);
+  check("columnar level names", reader.level_name(0) + "/" + reader.level_name(2), std::string("energy/label"));
+  typedef create_rtc< boost::mpl::vector<tagged<a_tag, float>, tagged<b_tag, int> >, RuntimeContainer<> >::type written_t;
+  typedef create_rtc< boost::mpl::vector<tagged<x_tag, int>, tagged<y_tag, float> >, RuntimeContainer<> >::type mismatched_t;
+  std::stringstream mismatchedStream;
+  {
+    std::vector<written_t> written(1);
+    rc_column_writer<written_t> writer(mismatchedStream, 2);
+    writer.write(written.begin(), written.end());
+  }
+  bool schemaThrown = false;
+  try {
+    rc_column_reader<mismatched_t> mismatchedReader(mismatchedStream);
+  } catch (const std::runtime_error&) {
+    schemaThrown = true;
+  }
+  check("columnar mismatched schema throws", schemaThrown, true);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing container expressions" << std::endl;
+  typedef create_rtc< boost::mpl::vector<int, double, std::vector<float> >, RuntimeContainer<> >::type ColumnContainer_t;
+  ColumnContainer_t ea, eb, ec;
+  ea.get<int>() = 1;
+  eb.get<int>() = 2;
+  ea.get<double>() = 0.5;
+  eb.get<double>() = 1.5;
+  ea = std::vector<float>{1.f, 2.f, 3.f};
+  eb = std::vector<float>{10.f, 20.f, 30.f};
+  ec = ea + 2 * eb;
+  std::cout << "  a + 2 * b: " << ec.get<int>() << " " << ec.get<double>() << " {";
+  for (auto element : ec.get()) std::cout << " " << element;
+  std::cout << " }" << std::endl;
+  check("a + 2 * b int", ec.get<int>(), 5);
+  check("a + 2 * b double", ec.get<double>(), 3.5);
+  check("a + 2 * b vector", ec.get() == std::vector<float>{21.f, 42.f, 63.f}, true);
+  ec = (ec - ea) / 2.f;
+  std::cout << "  (c - a) / 2: " << ec.get<int>() << " " << ec.get<double>() << " {";
+  for (auto element : ec.get()) std::cout << " " << element;
+  std::cout << " }" << std::endl;
+  check("(c - a) / 2 int", ec.get<int>(), 2);
+  check("(c - a) / 2 double", ec.get<double>(), 1.5);
+  check("(c - a) / 2 vector", ec.get() == std::vector<float>{10.f, 20.f, 30.f}, true);
+  eb = std::vector<float>{10.f, 20.f};
+  bool sizeThrown = false;
+  try {
+    ec = ea + eb;
+  } catch (const std::length_error&) {
+    sizeThrown = true;
+  }
+  check("operands of different size", sizeThrown, true);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing lazy levels" << std::endl;
+  typedef create_rtc< boost::mpl::vector<int, lazy<std::vector<int> >, tagged<label_tag, lazy<std::string> > >, RuntimeContainer<> >::type LazyContainer_t;
+  LazyContainer_t lazy_container;
+  std::cout << "  engaged after construction:";
+  lazy_container.for_each(print_engaged());
+  std::cout << std::endl;
+  lazy_container.get<label_tag>() = "original";
+  LazyContainer_t lazy_copy(lazy_container);
+  lazy_copy.get<std::vector<int> >().assign(3, 1);
+  std::cout << "  engaged after access:      ";
+  lazy_container.for_each(print_engaged());
+  std::cout << std::endl << "  engaged in modified copy:  ";
+  lazy_copy.for_each(print_engaged());
+  std::cout << std::endl << "  copy: " << lazy_copy.get<std::vector<int> >().size() << " elements, label " << lazy_copy.get<label_tag>() << std::endl;
+  check("elements in copy", lazy_copy.get<std::vector<int> >().size(), 3u);
+  check("label in copy", lazy_copy.get<label_tag>(), std::string("original"));
+  check("engaged vector level", static_cast<const boost::mpl::at_c<LazyContainer_t::types, 1>::type&>(lazy_container).engaged(), false);
+  static_assert(std::is_nothrow_move_constructible<LazyContainer_t>::value, "lazy levels must be nothrow movable");
+  typedef create_rtc< boost::mpl::vector<int, lazy<std::vector<int> >, lazy<std::string> >, RuntimeContainer<DefaultInterface, counting_initializer> >::type CountingContainer_t;
+  CountingContainer_t counting;
+  const CountingContainer_t& constCounting = counting;
+  constCounting.get<std::vector<int> >();
+  std::cout << "  initializer calls after const access: " << counting._initializer.mCount << std::endl;
+  check("initializer calls after const access", counting._initializer.mCount, 2);
+  std::thread lazyReader([&constCounting]() { constCounting.get<std::string>(); });
+  constCounting.get<std::string>();
+  lazyReader.join();
+  std::cout << "  initializer calls after concurrent access: " << counting._initializer.mCount << std::endl;
+  check("initializer calls after concurrent access", counting._initializer.mCount, 3);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing out of range dispatch" << std::endl;
+  std::cout << "  default policy: " << tagged_container.apply(3, get_value<float>()) << std::endl;
+  check("default policy out of range", tagged_container.apply(3, get_value<float>()), 0.f);
+  bool rangeThrown = false;
+  try {
+    tagged_container.apply_bounded<rc_bounds_throw>(3, get_value<float>());
+    std::cout << "  no exception" << std::endl;
+  } catch (const std::out_of_range& e) {
+    std::cout << "  throw policy: " << e.what() << std::endl;
+    rangeThrown = true;
+  }
+  check("throw policy out of range", rangeThrown, true);
+  std::error_code error;
+  float charge = tagged_container.apply(1, get_value<float>(), error);
+  std::cout << "  error code at 1: " << charge << " '" << error.message() << "'" << std::endl;
+  check("error code in range", (bool)error, false);
+  check("error code in range value", charge, (float)tagged_container.get<charge_tag>());
+  charge = tagged_container.apply(-1, get_value<float>(), error);
+  std::cout << "  error code at -1: '" << error.message() << "'" << std::endl;
+  check("error code out of range", error == std::errc::result_out_of_range, true);
+  check("error code out of range value", charge, 0.f);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing container pool" << std::endl;
+  ContainerPool<HeavyContainer_t> pool;
+  const HeavyContainer_t* recycled = nullptr;
+  {
+    auto pooled = pool.acquire();
+    pooled->set(std::vector<int>(100, 1));
+    recycled = pooled.get();
+  }
+  auto pooled = pool.acquire();
+  std::cout << "  recycled: " << (pooled.get() == recycled ? "yes" : "no") << ", constructed " << pool.constructed()
+            << ", size after reset " << pooled->get().size() << ", capacity " << pooled->get().capacity() << std::endl;
+  check("recycled container", pooled.get() == recycled, true);
+  check("constructed containers", pool.constructed(), 1u);
+  check("size after reset", pooled->get().size(), 0u);
+  check("capacity after reset", pooled->get().capacity(), 100u);
+  pooled.reset();
+  std::cout << "  available after release: " << pool.available() << std::endl;
+  check("available after release", pool.available(), 1u);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing pipeline" << std::endl;
+  Pipeline<PlainContainer_t> pipeline(8, 2);
+  double pipelineSum = 0.;
+  pipeline.add_container_stage("fill", [](PlainContainer_t& c, std::size_t index) { c.apply(index % 3, set_value<int>(index)); });
+  pipeline.add_stage("increment", add_value<int>(1));
+  pipeline.add_container_stage("reduce", [&pipelineSum](PlainContainer_t& c, std::size_t) {
+      for (int i = 0; i < 3; i++) pipelineSum += c.apply(i, get_value<double>());
+    });
+  pipeline.run(100);
+  std::cout << "  threaded sum: " << pipelineSum << std::endl;
+  // the sum of the fill indices and the increment of three levels per container
+  check("threaded pipeline sum", pipelineSum, 4950. + 3 * 100);
+  pipelineSum = 0.;
+  pipeline.run_inline(100);
+  std::cout << "  inline sum:   " << pipelineSum << std::endl;
+  check("inline pipeline sum", pipelineSum, 4950. + 3 * 100);
+  for (auto& stage : pipeline.stats()) {
+    std::cout << "  " << stage.name << ": " << stage.containers << " containers in " << stage.batches << " batches" << std::endl;
+    check("containers per stage", stage.containers, 200u);
+    check("batches per stage", stage.batches, 26u);
+  }
+  Pipeline<PlainContainer_t> numbering(4, 2);
+  double numberSum = 0.;
+  numbering.add_stage("number", number_levels());
+  numbering.add_container_stage("reduce", [&numberSum](PlainContainer_t& c, std::size_t) {
+      for (int i = 0; i < 3; i++) numberSum += c.apply(i, get_value<double>());
+    });
+  numbering.run(10);
+  // one functor numbers all levels of the stream: 0 to 29
+  check("stage functor state", numberSum, 435.);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing work stealing" << std::endl;
+  std::vector<std::vector<double> > chunked(3, std::vector<double>(1000, 0.));
+  rc_work_stealing_scheduler scheduler(3);
+  scheduler.for_each_chunked(reduced, fill_chunk(chunked), std::vector<std::size_t>{1000, 10, 500}, 64);
+  std::size_t executed = 0;
+  for (auto& worker : scheduler.stats()) executed += worker.executed;
+  std::cout << "  chunks executed: " << executed << std::endl;
+  check("chunks executed", executed, 25u);
+  const double chunkedSums[] = {1501500., 10035., 624250.};
+  for (int i = 0; i < 3; i++) {
+    std::cout << "  level " << i << ": " << std::accumulate(chunked[i].begin(), chunked[i].end(), 0.) << std::endl;
+    check("chunked level", std::accumulate(chunked[i].begin(), chunked[i].end(), 0.), chunkedSums[i]);
+  }
+  scheduler.for_each_chunked(reduced, fill_chunk(chunked), std::vector<std::size_t>{1000, 10, 500}, 64);
+  executed = 0;
+  for (auto& worker : scheduler.stats()) executed += worker.executed;
+  check("chunks executed in the second call", executed, 25u);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing instrumentation" << std::endl;
+  typedef rc_timing_instrumentation<rc_steady_clock, label_tag> Instrumentation_t;
+  typedef RuntimeContainer<DefaultInterface, default_initializer, default_printer, no_tracking, Instrumentation_t> InstrumentedBase_t;
+  typedef create_rtc< tagged_types, InstrumentedBase_t >::type InstrumentedContainer_t;
+  static_assert(sizeof(InstrumentedContainer_t) == sizeof(TaggedContainer_t), "instrumentation changes the container size");
+  InstrumentedContainer_t instrumented;
+  instrumented.get<label_tag>() = 'i';
+  instrumented.for_each(print_level());
+  instrumented.apply(1, print_level());
+  instrumented.apply(5, print_level());
+  std::thread([&instrumented]() { instrumented.apply(1, print_level()); }).join();
+  rc_timing_table timing = Instrumentation_t::collect();
+  std::vector<std::string> levelNames = rc_level_names<InstrumentedContainer_t>();
+  for (std::size_t i = 0; i < timing.size(); i++) {
+    std::cout << "  " << levelNames[i] << ": " << timing[i].calls << " calls" << std::endl;
+  }
+  std::ostringstream collapsed;
+  rc_write_collapsed(collapsed, timing, "container", levelNames);
+  std::string stacks = collapsed.str();
+  std::cout << "  collapsed stacks: " << std::count(stacks.begin(), stacks.end(), '\n') << std::endl;
+  // for_each calls every level once, level 1 is also applied twice, once from the other thread;
+  // the out of range apply records nothing and does not grow the table
+  check("instrumented levels", timing.size(), std::size_t(3));
+  const std::uint64_t levelCalls[3] = {1, 3, 1};
+  for (std::size_t i = 0; i < timing.size() && i < 3; i++) {
+    check("instrumented calls", timing[i].calls, levelCalls[i]);
+  }
+  check("collapsed stack lines", std::count(stacks.begin(), stacks.end(), '\n'), std::ptrdiff_t(3));
+  check("collapsed stacks", stacks.find("container;energy ") == 0 && stacks.find("\ncontainer;charge ") != std::string::npos &&
+        stacks.find("\ncontainer;label ") != std::string::npos, true);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing shape factory" << std::endl;
+  typedef rc_for_each_visitor<set_value<int> > SetVisitor_t;
+  typedef rc_for_each_visitor<print_level> PrintVisitor_t;
+  typedef rc_for_each_visitor<count_equal> CountVisitor_t;
+  typedef rc_shape_factory<tagged_types, RuntimeContainer<>, SetVisitor_t, PrintVisitor_t, CountVisitor_t> ShapeFactory_t;
+  static_assert(boost::mpl::size<ShapeFactory_t::container<0x5>::type::types>::value == 2, "wrong number of levels");
+  SetVisitor_t setVisitor(set_value<int>(65));
+  PrintVisitor_t printVisitor;
+  const std::uint64_t shapes[3] = {0x5, 0x2, 0x0};
+  const std::size_t shapeLevels[3] = {2, 1, 0};
+  for (int i = 0; i < 3; i++) {
+    ShapeFactory_t::handle batch = ShapeFactory_t::create(shapes[i]);
+    batch->resize(2);
+    batch->accept(setVisitor);
+    std::cout << "  shape " << batch->shape() << ": " << batch->levels() << " levels, " << batch->size() << " containers" << std::endl;
+    batch->accept(printVisitor);
+    int nset = 0;
+    CountVisitor_t countVisitor(count_equal(65, nset));
+    batch->accept(countVisitor);
+    check("shape", batch->shape(), shapes[i]);
+    check("shape levels", batch->levels(), shapeLevels[i]);
+    check("shape size", batch->size(), std::size_t(2));
+    check("shape levels set", nset, int(2 * shapeLevels[i]));
+  }
+  typedef boost::mpl::vector_c<std::uint64_t, 0x1, 0x7> SelectedShapes_t;
+  std::cout << "  selected shape 0x7: " << (ShapeFactory_t::create_selected<SelectedShapes_t>(0x7) ? "created" : "null") << std::endl;
+  std::cout << "  selected shape 0x3: " << (ShapeFactory_t::create_selected<SelectedShapes_t>(0x3) ? "created" : "null") << std::endl;
+  check("selected shape 0x7 created", ShapeFactory_t::create_selected<SelectedShapes_t>(0x7) != nullptr, true);
+  check("selected shape 0x3 null", ShapeFactory_t::create_selected<SelectedShapes_t>(0x3) == nullptr, true);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  std::cout << std::endl << "testing heterogeneous vector" << std::endl;
+  HeterogeneousVector<types> hvector;
+  hvector.push_back(1);
+  hvector.push_back(2.5f);
+  hvector.push_back('a');
+  hvector.push_back(3);
+  hvector.emplace_back<unsigned int>(4u);
+  hvector.push_back(5.5f);
+  std::cout << "insertion order:";
+  hvector.for_each(print_element());
+  std::cout << std::endl << "grouped by type:";
+  hvector.for_each_grouped(print_element());
+  std::cout << std::endl << "element 3 is " << (hvector.holds<int>(3) ? "" : "not ") << "an int: "
+            << *hvector.get_if<int>(3) << std::endl;
+  std::vector<float> results;
+  hvector.transform(doubled_element(), results);
+  std::cout << "doubled, type-sorted:";
+  for (auto result : results) std::cout << " " << result;
+  HeterogeneousVector<types>::partition_type hpartition = hvector.partition();
+  hvector.transform(doubled_element(), results, hpartition);
+  std::cout << std::endl << "doubled, original order:";
+  for (auto result : results) std::cout << " " << result;
+  std::cout << std::endl;
+  check("doubled, original order", results == std::vector<float>{2.f, 5.f, 194.f, 6.f, 8.f, 11.f}, true);
+  hvector.push_back(6);
+  bool partitionThrown = false;
+  try {
+    hvector.transform(doubled_element(), results, hpartition);
+  } catch (const std::invalid_argument&) {
+    partitionThrown = true;
+  }
+  check("outdated partition", partitionThrown, true);
+
+  if (failures > 0) {
+    std::cout << std::endl << failures << " checks failed" << std::endl;
+    return 1;
+  }
+  return 0;
 }
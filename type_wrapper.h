@@ -0,0 +1,105 @@
+//-*- Mode: C++ -*-
+
+#ifndef TYPE_WRAPPER_H
+#define TYPE_WRAPPER_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Authors: Matthias Richter <richterm@scieq.net>                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+/// @file   type_wrapper.h
+/// @author Matthias Richter
+/// @since  2015-10-13
+/// @brief  Type wrappers with and without virtual interface for the benchmarks
+/// This file is part of https://github.com/matthiasrichter/gNeric
+
+// The wrappers of compare_polymorphism.cxx, shared with the other programs
+// comparing runtime containers with a vector of pointers to a virtual
+// interface.
+
+#include <iostream>
+#include <iomanip>
+#include <type_traits>
+
+/**
+ * @brief Common interface for type wrappers
+ * This is a pure virtual interface class for the runtime polymorphic
+ * case and not needed for the static polymorphic case.
+ */
+class Interface {
+public:
+  typedef Interface self_type;
+
+  Interface() {}
+  virtual ~Interface() {}
+
+  virtual void print() const = 0;
+  virtual self_type& operator+=(int value) = 0;
+  virtual double value() const = 0;
+  virtual int count() const = 0;
+
+private:
+};
+
+/**
+ * @brief Empty base for the type wrappers in the static polymorphic case
+ */
+class NoInterface {
+};
+
+/**
+ * @brief Wrapper class to test the virtual interface
+ * The class can wrap an arbitrary type which implements operator++ and
+ * the output stream operator. The functions override the virtual interface
+ * if it is the base, otherwise they are plain member functions.
+ */
+template<typename T, typename Base = Interface>
+class TypeWrapper : public Base {
+public:
+  typedef TypeWrapper self_type;
+  typedef T wrapped_type;
+
+  TypeWrapper() : mMember(0), mCount(0) {}
+  ~TypeWrapper() {}
+
+  void print() const {
+    const char* typeName = "unknown";
+    if (std::is_floating_point<wrapped_type>::value)
+      typeName = "float";
+    if (std::is_integral<wrapped_type>::value) {
+      if (std::is_signed<wrapped_type>::value)
+        typeName = "signed int";
+      else
+        typeName = "unsigned int";
+    }
+
+    std::cout << "I'm a "
+              << std::setw(12) << typeName << " type,"
+              << " of size " << sizeof(wrapped_type)
+              << " value " << std::setw(10) << std::setprecision(4) << mMember
+              << "  - called " << std::setw(10) << mCount << " time(s)"
+              << std::endl;
+  }
+
+  self_type& operator+=(int value) {
+    mMember += value;
+    ++mCount;
+    return *this;
+  }
+
+  double value() const { return mMember; }
+  int count() const { return mCount; }
+
+private:
+  T mMember;
+  int mCount;
+};
+
+#endif